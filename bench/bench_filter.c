@@ -0,0 +1,169 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/******************************************************************************
+ * Counts the rows of a parsed batch inside ">=4.2.0 <5.0.0", once with
+ * semver_batch_filter and once with semver_compare on every row.
+ *
+ * Build and run from the repository root, with or without -mavx2:
+ *
+ *   gcc -std=gnu99 -O2 -mavx2 -pthread -Iinclude -Isrc bench/bench_filter.c \
+ *       src/semver.c src/semver_batch.c src/semver_filter.c \
+ *       -o bench_filter && ./bench_filter [rows] [passes]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "semver.h"
+#include "semver_batch.h"
+#include "semver_filter.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define DEFAULT_ROWS   1000000
+#define DEFAULT_PASSES 20
+#define MAX_LINE_LEN   32
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static const char* g_pr_strs[] = { "", "", "", "", "", "", "-rc.1", "-beta.2" };
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static double now_ns(void);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int main(int argc, char ** argv)
+{
+    int num_rows = (argc > 1)? atoi(argv[1]) : DEFAULT_ROWS;
+    int passes = (argc > 2)? atoi(argv[2]) : DEFAULT_PASSES;
+    semver_batch_t *p_batch;
+    semver_interval_t interval;
+    semver_t *p_lo = NULL;
+    semver_t *p_hi = NULL;
+    semver_t *semvers;
+    uint64_t *mask;
+    char *buf;
+    size_t len = 0;
+    size_t num_filter = 0;
+    size_t num_compare = 0;
+    double start;
+    double ns_filter;
+    double ns_compare;
+    int pass;
+    int cmp;
+    int i;
+
+    if(num_rows <= 0 || passes <= 0)
+    {
+        fprintf(stderr, "%s [rows] [passes]\n", argv[0]);
+        return 1;
+    }
+
+    //Versions clustered around the range, so every level of the compare
+    //gets exercised.
+    buf = (char*)malloc((size_t)num_rows * MAX_LINE_LEN);
+    srand(2015);
+    for(i=0;i<num_rows;i++)
+    {
+        len += snprintf(buf + len, MAX_LINE_LEN, "%d.%d.%d%s\n",
+                        3 + rand() % 3, rand() % 12, rand() % 20,
+                        g_pr_strs[rand() % (sizeof(g_pr_strs)/sizeof(char*))]);
+    }
+
+    semver_batch_parse(buf, len, &p_batch);
+    semvers = (semver_t*)malloc(p_batch->count * sizeof(semver_t));
+    for(i=0;i<num_rows;i++)
+    {
+        semver_t *p_semver;
+
+        semver_str_to_semver(buf + p_batch->line_off[i], p_batch->line_len[i], &p_semver);
+        semvers[i] = *p_semver;
+        free(p_semver);
+    }
+
+    semver_str_to_semver("4.2.0", 5, &p_lo);
+    semver_str_to_semver("5.0.0", 5, &p_hi);
+    semver_interval_compile(&interval, p_lo, p_hi, 0);
+    mask = (uint64_t*)malloc(SEMVER_MASK_WORDS(p_batch->count) * sizeof(uint64_t));
+
+    start = now_ns();
+    for(pass=0;pass<passes;pass++)
+    {
+        semver_batch_filter(p_batch, buf, &interval, mask, &num_filter);
+    }
+    ns_filter = (now_ns() - start) / ((double)passes * num_rows);
+
+    start = now_ns();
+    for(pass=0;pass<passes;pass++)
+    {
+        num_compare = 0;
+        for(i=0;i<num_rows;i++)
+        {
+            semver_compare(&semvers[i], p_lo, &cmp);
+            if(cmp >= 0)
+            {
+                semver_compare(&semvers[i], p_hi, &cmp);
+                num_compare += (cmp < 0);
+            }
+        }
+    }
+    ns_compare = (now_ns() - start) / ((double)passes * num_rows);
+
+    if(num_filter != num_compare)
+    {
+        fprintf(stderr, "filter disagrees: %zu vs %zu rows\n", num_filter, num_compare);
+        return 1;
+    }
+
+    printf("%d rows x %d passes, %zu in >=4.2.0 <5.0.0\n", num_rows, passes, num_filter);
+    printf("semver_batch_filter:    %6.2f ns/row\n", ns_filter);
+    printf("semver_compare per row: %6.2f ns/row\n", ns_compare);
+
+    for(i=0;i<num_rows;i++)
+    {
+        semver_fini(&semvers[i]);
+    }
+    free(semvers);
+    free(mask);
+    semver_destroy(p_lo);
+    semver_destroy(p_hi);
+    semver_batch_destroy(p_batch);
+    free(buf);
+
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
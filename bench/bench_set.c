@@ -0,0 +1,296 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/******************************************************************************
+ * Multithreaded stress and scaling benchmark for semver_set: every thread
+ * publishes its share of the versions while looking up floors of versions
+ * the others publish, first against the skip list, then against a sorted
+ * array behind one global mutex.
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -std=gnu99 -O2 -pthread -Iinclude -Isrc bench/bench_set.c \
+ *       src/semver.c src/semver_set.c -o bench_set && ./bench_set [threads] [versions]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "semver.h"
+#include "semver_set.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define DEFAULT_THREADS  8
+#define DEFAULT_VERSIONS 200000
+#define LOOKUPS_PER_INSERT 4
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef struct worker_
+{
+    pthread_t thread;
+    int index;
+    unsigned num_found;
+} worker_t;
+
+typedef void (*insert_fn_t)(const semver_t *p_semver);
+typedef int (*floor_fn_t)(const semver_t *p_semver);
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static const char* g_pr_strs[] = { "", "-alpha.1", "-beta.2", "-rc.1" };
+
+static semver_t *g_versions;
+static int g_num_versions;
+static int g_num_threads;
+
+static semver_set_t *g_p_set;
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static const semver_t **g_sorted;
+static int g_num_sorted;
+
+static insert_fn_t g_insert;
+static floor_fn_t g_floor;
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void make_versions(void);
+static double run(insert_fn_t insert, floor_fn_t floor_fn, unsigned *po_num_found);
+static void* worker(void *p_arg);
+static void set_insert(const semver_t *p_semver);
+static int set_floor(const semver_t *p_semver);
+static int lower_bound(const semver_t *p_semver);
+static void locked_insert(const semver_t *p_semver);
+static int locked_floor(const semver_t *p_semver);
+static double now_ns(void);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int main(int argc, char ** argv)
+{
+    unsigned num_found_set;
+    unsigned num_found_locked;
+    double ns_set;
+    double ns_locked;
+    int i;
+
+    g_num_threads = (argc > 1)? atoi(argv[1]) : DEFAULT_THREADS;
+    g_num_versions = (argc > 2)? atoi(argv[2]) : DEFAULT_VERSIONS;
+
+    if(g_num_threads <= 0 || g_num_versions <= 0)
+    {
+        fprintf(stderr, "%s [threads] [versions]\n", argv[0]);
+        return 1;
+    }
+
+    make_versions();
+
+    semver_set_create(&g_p_set);
+    ns_set = run(set_insert, set_floor, &num_found_set);
+
+    if((int)semver_set_size(g_p_set) != g_num_versions)
+    {
+        fprintf(stderr, "set holds %zu of %d versions\n", semver_set_size(g_p_set), g_num_versions);
+        return 1;
+    }
+    semver_set_destroy(g_p_set);
+
+    g_sorted = (const semver_t**)malloc(g_num_versions * sizeof(semver_t*));
+    ns_locked = run(locked_insert, locked_floor, &num_found_locked);
+    free(g_sorted);
+
+    printf("%d threads, %d versions, %d floor lookups per insert\n",
+           g_num_threads, g_num_versions, LOOKUPS_PER_INSERT);
+    printf("skip list:            %8.1f ns/insert, %u floors found\n", ns_set, num_found_set);
+    printf("mutex + sorted array: %8.1f ns/insert, %u floors found\n", ns_locked, num_found_locked);
+
+    for(i=0;i<g_num_versions;i++)
+    {
+        semver_fini(&g_versions[i]);
+    }
+    free(g_versions);
+
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+//Distinct versions in random order, a few of them pre-releases.
+static void make_versions(void)
+{
+    char semver_str[48];
+    semver_t *p_semver;
+    int i;
+    int j;
+
+    g_versions = (semver_t*)malloc(g_num_versions * sizeof(semver_t));
+
+    for(i=0;i<g_num_versions;i++)
+    {
+        snprintf(semver_str, sizeof(semver_str), "%d.%d.%d%s",
+                 i / 4000, (i / 40) % 100, (i / 4) % 10, g_pr_strs[i % 4]);
+        semver_str_to_semver(semver_str, strlen(semver_str), &p_semver);
+        g_versions[i] = *p_semver;
+        free(p_semver);
+    }
+
+    srand(2015);
+    for(i=g_num_versions-1;i>0;i--)
+    {
+        semver_t tmp = g_versions[i];
+
+        j = rand() % (i + 1);
+        g_versions[i] = g_versions[j];
+        g_versions[j] = tmp;
+    }
+}
+
+static double run(insert_fn_t insert, floor_fn_t floor_fn, unsigned *po_num_found)
+{
+    worker_t *workers;
+    double start;
+    double elapsed;
+    int i;
+
+    g_insert = insert;
+    g_floor = floor_fn;
+
+    workers = (worker_t*)calloc(g_num_threads, sizeof(worker_t));
+
+    start = now_ns();
+    for(i=0;i<g_num_threads;i++)
+    {
+        workers[i].index = i;
+        pthread_create(&workers[i].thread, NULL, worker, &workers[i]);
+    }
+
+    *po_num_found = 0;
+    for(i=0;i<g_num_threads;i++)
+    {
+        pthread_join(workers[i].thread, NULL);
+        *po_num_found += workers[i].num_found;
+    }
+    elapsed = now_ns() - start;
+
+    free(workers);
+    return elapsed / g_num_versions;
+}
+
+//Inserts every num_threads-th version; looks up floors of others.
+static void* worker(void *p_arg)
+{
+    worker_t *p_worker = (worker_t*)p_arg;
+    int i;
+    int j;
+
+    for(i=p_worker->index;i<g_num_versions;i+=g_num_threads)
+    {
+        g_insert(&g_versions[i]);
+
+        for(j=1;j<=LOOKUPS_PER_INSERT;j++)
+        {
+            p_worker->num_found += (0 == g_floor(&g_versions[(i + 7919*j) % g_num_versions]));
+        }
+    }
+
+    return NULL;
+}
+
+static void set_insert(const semver_t *p_semver)
+{
+    semver_set_insert(g_p_set, p_semver);
+}
+
+static int set_floor(const semver_t *p_semver)
+{
+    const semver_t *p_found;
+
+    return semver_set_floor(g_p_set, p_semver, &p_found);
+}
+
+//Index of the first element not preceding p_semver. Caller holds g_lock.
+static int lower_bound(const semver_t *p_semver)
+{
+    int lo = 0;
+    int hi = g_num_sorted;
+    int mid;
+    int cmp;
+
+    while(lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        semver_compare(g_sorted[mid], p_semver, &cmp);
+        if(cmp < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static void locked_insert(const semver_t *p_semver)
+{
+    int pos;
+
+    pthread_mutex_lock(&g_lock);
+    pos = lower_bound(p_semver);
+    memmove(&g_sorted[pos + 1], &g_sorted[pos], (g_num_sorted - pos) * sizeof(semver_t*));
+    g_sorted[pos] = p_semver;
+    g_num_sorted++;
+    pthread_mutex_unlock(&g_lock);
+}
+
+static int locked_floor(const semver_t *p_semver)
+{
+    int pos;
+    int cmp = -1;
+
+    pthread_mutex_lock(&g_lock);
+    pos = lower_bound(p_semver);
+    if(pos < g_num_sorted)
+    {
+        semver_compare(g_sorted[pos], p_semver, &cmp);
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    return (0 == cmp || pos > 0)? 0 : 1;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
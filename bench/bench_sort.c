@@ -0,0 +1,178 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/******************************************************************************
+ * Sorts an array of versions with qsort and a semver_compare comparator,
+ * then with semver_sort, then with semver_sort_parallel on 1, 2, 4, ...
+ * threads up to max_threads (default: one per online CPU).
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -std=gnu99 -O2 -Iinclude -Isrc bench/bench_sort.c src/semver.c \
+ *       src/semver_sort.c -pthread -o bench_sort && ./bench_sort [versions] [max_threads]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "semver.h"
+#include "semver_sort.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define DEFAULT_VERSIONS 1000000
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static const char* g_pr_strs[] = { "", "", "", "", "", "", "-rc.1", "-beta.2", "-alpha" };
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static int qsort_cmp(const void *p_a, const void *p_b);
+static int check_sorted(const semver_t *p_semvers, size_t num);
+static double now_ns(void);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int main(int argc, char ** argv)
+{
+    int num = (argc > 1)? atoi(argv[1]) : DEFAULT_VERSIONS;
+    int max_threads = (argc > 2)? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    semver_t *p_semvers;
+    semver_t *p_copy;
+    char semver_str[48];
+    double start;
+    double ms_qsort;
+    double ms_sort;
+    double ms_parallel;
+    int threads;
+    int i;
+
+    if(num <= 0 || max_threads <= 0)
+    {
+        fprintf(stderr, "%s [versions] [max_threads]\n", argv[0]);
+        return 1;
+    }
+
+    //A registry's worth: mostly small numbers, a few pre-releases.
+    p_semvers = (semver_t*)malloc(num * sizeof(semver_t));
+    p_copy = (semver_t*)malloc(num * sizeof(semver_t));
+    srand(2015);
+    for(i=0;i<num;i++)
+    {
+        semver_t *p_semver;
+
+        snprintf(semver_str, sizeof(semver_str), "%d.%d.%d%s",
+                 rand() % 30, rand() % 50, rand() % 200,
+                 g_pr_strs[rand() % (sizeof(g_pr_strs)/sizeof(char*))]);
+        semver_str_to_semver(semver_str, strlen(semver_str), &p_semver);
+        p_semvers[i] = *p_semver;
+        free(p_semver);
+    }
+
+    //Both sorts only move the structs around, so a bitwise copy is a fair
+    //second input.
+    memcpy(p_copy, p_semvers, num * sizeof(semver_t));
+    start = now_ns();
+    qsort(p_copy, num, sizeof(semver_t), qsort_cmp);
+    ms_qsort = (now_ns() - start) / 1e6;
+
+    memcpy(p_copy, p_semvers, num * sizeof(semver_t));
+    start = now_ns();
+    semver_sort(p_copy, num);
+    ms_sort = (now_ns() - start) / 1e6;
+
+    if(0 != check_sorted(p_copy, num))
+    {
+        fprintf(stderr, "semver_sort left the array unsorted\n");
+        return 1;
+    }
+
+    printf("%d versions\n", num);
+    printf("qsort + semver_compare: %8.1f ms\n", ms_qsort);
+    printf("semver_sort:            %8.1f ms\n", ms_sort);
+
+    for(threads=1;threads<=max_threads;threads*=2)
+    {
+        memcpy(p_copy, p_semvers, num * sizeof(semver_t));
+        start = now_ns();
+        semver_sort_parallel(p_copy, num, threads);
+        ms_parallel = (now_ns() - start) / 1e6;
+
+        if(0 != check_sorted(p_copy, num))
+        {
+            fprintf(stderr, "semver_sort_parallel left the array unsorted\n");
+            return 1;
+        }
+
+        printf("semver_sort_parallel, %2d threads: %8.1f ms (%.2fx)\n",
+               threads, ms_parallel, ms_sort / ms_parallel);
+    }
+
+    for(i=0;i<num;i++)
+    {
+        semver_fini(&p_semvers[i]);
+    }
+    free(p_semvers);
+    free(p_copy);
+
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static int qsort_cmp(const void *p_a, const void *p_b)
+{
+    int result = 0;
+
+    semver_compare((const semver_t*)p_a, (const semver_t*)p_b, &result);
+    return result;
+}
+
+static int check_sorted(const semver_t *p_semvers, size_t num)
+{
+    int result;
+    size_t i;
+
+    for(i=1;i<num;i++)
+    {
+        semver_compare(&p_semvers[i-1], &p_semvers[i], &result);
+        if(result > 0)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
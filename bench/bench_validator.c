@@ -0,0 +1,225 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/******************************************************************************
+ * Compares the re2c switch DFA against the table-driven validator, and
+ * semver_str_is_valid one string at a time against semver_validate_many.
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -std=gnu99 -O2 -Iinclude -Isrc bench/bench_validator.c src/semver.c \
+ *       -o bench_validator && ./bench_validator [passes]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "semver.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define NUM_STRS     4096
+#define MAX_STR_LEN  48
+#define DEFAULT_PASSES 500
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef int (*validator_fn_t)(const char* semver_str,
+                              size_t semver_str_len,
+                              bool *po_has_primary,
+                              bool *po_has_pre_release,
+                              bool *po_has_bmd);
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static const char* g_pr_strs[] = { "", "-alpha", "-rc.1", "-beta.11", "-0.3.7", "-x.7.z.92" };
+static const char* g_bmd_strs[] = { "", "", "+build.7", "+sha.5114f85", "+20150223.ci" };
+
+static char g_strs[NUM_STRS][MAX_STR_LEN];
+static const char* g_ptrs[NUM_STRS];
+static size_t g_lens[NUM_STRS];
+static uint8_t g_status[NUM_STRS];
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void make_corpus(void);
+static double run(validator_fn_t validator, int passes, unsigned *po_num_valid);
+static double run_one_by_one(int passes, unsigned *po_num_valid);
+static double run_many(int passes, unsigned *po_num_valid);
+static double now_ns(void);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int main(int argc, char ** argv)
+{
+    int passes = (argc > 1)? atoi(argv[1]) : DEFAULT_PASSES;
+    unsigned num_valid_re2c;
+    unsigned num_valid_table;
+    unsigned num_valid_one;
+    unsigned num_valid_many;
+    double ns_re2c;
+    double ns_table;
+    double ns_one;
+    double ns_many;
+
+    if(passes <= 0)
+    {
+        fprintf(stderr, "%s [passes]\n", argv[0]);
+        return 1;
+    }
+
+    make_corpus();
+
+    //Warm up both, then measure.
+    run(semver_str_validator_re2c, 1, &num_valid_re2c);
+    run(semver_str_validator_table, 1, &num_valid_table);
+    ns_re2c = run(semver_str_validator_re2c, passes, &num_valid_re2c);
+    ns_table = run(semver_str_validator_table, passes, &num_valid_table);
+
+    run_one_by_one(1, &num_valid_one);
+    run_many(1, &num_valid_many);
+    ns_one = run_one_by_one(passes, &num_valid_one);
+    ns_many = run_many(passes, &num_valid_many);
+
+    if(num_valid_re2c != num_valid_table)
+    {
+        fprintf(stderr, "engines disagree: %u vs %u valid\n", num_valid_re2c, num_valid_table);
+        return 1;
+    }
+
+    if(num_valid_one != num_valid_many)
+    {
+        fprintf(stderr, "batch disagrees: %u vs %u valid\n", num_valid_one, num_valid_many);
+        return 1;
+    }
+
+    printf("%d strings x %d passes, %u valid per pass\n", NUM_STRS, passes, num_valid_re2c);
+    printf("re2c switch DFA: %6.2f ns/string\n", ns_re2c);
+    printf("table DFA:       %6.2f ns/string\n", ns_table);
+    printf("\n%u fully valid per pass\n", num_valid_one);
+    printf("semver_str_is_valid:  %6.2f ns/string\n", ns_one);
+    printf("semver_validate_many: %6.2f ns/string\n", ns_many);
+
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+//Mostly valid versions of typical shapes, with one in eight corrupted.
+static void make_corpus(void)
+{
+    int i;
+
+    srand(2015);
+    for(i=0;i<NUM_STRS;i++)
+    {
+        g_ptrs[i] = g_strs[i];
+        g_lens[i] = snprintf(g_strs[i], MAX_STR_LEN, "%d.%d.%d%s%s",
+                             rand() % 20, rand() % 100, rand() % 1000,
+                             g_pr_strs[rand() % (sizeof(g_pr_strs)/sizeof(char*))],
+                             g_bmd_strs[rand() % (sizeof(g_bmd_strs)/sizeof(char*))]);
+
+        if(0 == rand() % 8)
+        {
+            g_strs[i][rand() % g_lens[i]] = "!._+-"[rand() % 5];
+        }
+    }
+}
+
+static double run(validator_fn_t validator, int passes, unsigned *po_num_valid)
+{
+    unsigned num_valid = 0;
+    double start;
+    int pass;
+    int i;
+
+    start = now_ns();
+    for(pass=0;pass<passes;pass++)
+    {
+        num_valid = 0;
+        for(i=0;i<NUM_STRS;i++)
+        {
+            num_valid += (0 == validator(g_strs[i], g_lens[i], NULL, NULL, NULL));
+        }
+    }
+
+    *po_num_valid = num_valid;
+    return (now_ns() - start) / ((double)passes * NUM_STRS);
+}
+
+static double run_one_by_one(int passes, unsigned *po_num_valid)
+{
+    unsigned num_valid = 0;
+    double start;
+    int pass;
+    int i;
+
+    start = now_ns();
+    for(pass=0;pass<passes;pass++)
+    {
+        num_valid = 0;
+        for(i=0;i<NUM_STRS;i++)
+        {
+            num_valid += (0 == semver_str_is_valid(g_strs[i], g_lens[i]));
+        }
+    }
+
+    *po_num_valid = num_valid;
+    return (now_ns() - start) / ((double)passes * NUM_STRS);
+}
+
+static double run_many(int passes, unsigned *po_num_valid)
+{
+    unsigned num_valid = 0;
+    double start;
+    int pass;
+    int i;
+
+    start = now_ns();
+    for(pass=0;pass<passes;pass++)
+    {
+        semver_validate_many(g_ptrs, g_lens, NUM_STRS, g_status);
+
+        num_valid = 0;
+        for(i=0;i<NUM_STRS;i++)
+        {
+            num_valid += (0 == g_status[i]);
+        }
+    }
+
+    *po_num_valid = num_valid;
+    return (now_ns() - start) / ((double)passes * NUM_STRS);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
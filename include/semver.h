@@ -19,6 +19,8 @@
 #define _semver_h_
 
 #include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /*!*****************************************************************************
  * @file semver.h
@@ -45,6 +47,27 @@
  * #defines
  ******************************************************************************/
 
+/* Bytes of pre-release and build meta-data text (including a NUL after
+ * each) held inside semver_t before spilling to the heap. The default makes
+ * semver_t 64 bytes on LP64 hosts; override at build time to taste. */
+#ifndef SEMVER_INLINE_TAIL_LEN
+#define SEMVER_INLINE_TAIL_LEN 32
+#endif
+
+/* Flags for semver_parse_ex. The whole string is validated regardless. */
+
+/* Don't store the build meta-data. It never affects precedence. */
+#define SEMVER_SKIP_BMD      (1u << 0)
+/* Store only MAJOR.MINOR.PATCH. */
+#define SEMVER_PRIMARY_ONLY  (1u << 1)
+/* Point into the parsed string instead of copying the pre-release and build
+ * meta-data out of it. The string must then outlive the semver, and the
+ * build meta-data is not NUL terminated. The semver takes a private copy
+ * the first time it is modified. */
+#define SEMVER_NO_COPY       (1u << 2)
+/* Only validate; no semver is created and p2o_semver may be NULL. */
+#define SEMVER_VALIDATE_ONLY (1u << 3)
+
 /******************************************************************************
  * type definitions /enums
  ******************************************************************************/
@@ -52,6 +75,13 @@
 struct semver_;
 typedef struct semver_ semver_t;
 
+/* Kinds of pre-release identifier; they compare differently. */
+typedef enum semver_id_type_
+{
+    SEMVER_ID_NUMERIC,
+    SEMVER_ID_ALPHANUMERIC
+} semver_id_type_t;
+
 /******************************************************************************
  * function prototypes
  ******************************************************************************/
@@ -64,7 +94,7 @@ typedef struct semver_ semver_t;
  *
  *  @param p2o_semver Second pointer to the semver to be create
  *
- *  @return 0 for success, nonzero otherwise
+ *  @return 0 for success, positive if invalid, negative if out of memory
  *****************************************************************************/
 int semver_create(semver_t **p2o_semver);
 
@@ -77,6 +107,73 @@ int semver_create(semver_t **p2o_semver);
  *****************************************************************************/
 int semver_destroy(semver_t *po_semver);
 
+/******************************************************************************
+ *  @brief Initializes caller-owned storage as a semantic version context,
+ *         e.g. a semver_t on the stack, inside another struct or in an
+ *         array of values.
+ *
+ *   NOTE: Initialized semvers are 0.0.0, as with semver_create. Anything
+ *         initialized with semver_init must be released with semver_fini,
+ *         never semver_destroy.
+ *
+ *  @param po_semver Pointer to the storage to initialize.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_init(semver_t *po_semver);
+
+/******************************************************************************
+ *  @brief Releases everything a semver owns, but not its storage. The
+ *         semver is left as if freshly initialized.
+ *
+ *  @param po_semver Pointer to the semver to be deinitialized.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_fini(semver_t *po_semver);
+
+/******************************************************************************
+ *  @brief Makes an immutable, reference counted copy of a semver, to be
+ *         shared between threads without copying or locking.
+ *
+ *         Frozen semvers must never be modified. Every function that takes
+ *         a const semver_t, such as semver_compare, the getters and
+ *         semver_to_str, is safe to call on one from any number of threads
+ *         at once. The copy is independent of p_semver, which may be
+ *         changed or released right away.
+ *
+ *         Semvers handed out by semver_cache_get are frozen semvers too.
+ *
+ *   NOTE: Release frozen semvers with semver_unref, never semver_destroy
+ *         or semver_fini. semver_ref and semver_unref must only ever be
+ *         given frozen semvers.
+ *
+ *  @param p_semver   The semver to copy.
+ *  @param p2o_frozen (OUTPARAM) The frozen copy, holding one reference.
+ *
+ *  @return 0 for success, positive if invalid, negative if out of memory
+ *****************************************************************************/
+int semver_freeze(const semver_t *p_semver, const semver_t **p2o_frozen);
+
+/******************************************************************************
+ *  @brief Takes another reference to a frozen semver. Safe to call from any
+ *         thread that already holds a reference.
+ *
+ *  @param p_frozen The frozen semver.
+ *
+ *  @return p_frozen
+ *****************************************************************************/
+const semver_t* semver_ref(const semver_t *p_frozen);
+
+/******************************************************************************
+ *  @brief Drops a reference to a frozen semver; the last one frees it.
+ *
+ *  @param p_frozen The frozen semver.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_unref(const semver_t *p_frozen);
+
 /******************************************************************************
  *  @brief Returns the major version of the semver.
  *
@@ -123,7 +220,8 @@ int semver_get_pr_str(const semver_t *p_semver,
  *         outparam. If the build meta-data component of the semver does not
  *         exist, then the bmd_str outparam shall be set to NULL.
  *
- *         NOTE: It is responsibility of the user to free *p2o_bmd_str
+ *         NOTE: *p2o_bmd_str points at the semver's own storage and must
+ *               not be freed; see semver_get_bmd_span.
  *         NOTE2: str_len does not include the terminating NULL byte.
  *
  *  @param p_semver   Pointer to the semver.
@@ -134,6 +232,63 @@ int semver_get_bmd_str(const semver_t *p_semver,
                       char** p2o_bmd_str,
                       uint16_t *po_str_len);
 
+/******************************************************************************
+ *  @brief Points at the dotted pre-release text of the semver, without
+ *         copying it. If there is no pre-release, *p2o_str is set to NULL
+ *         and *po_len to 0.
+ *
+ *         The text belongs to the semver and stays valid until the semver
+ *         is modified or released. It is not necessarily NUL terminated.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @param p2o_str  (OUTPARAM) The pre-release text.
+ *  @param po_len   (OUTPARAM) Its length.
+ *  @return 0 upon success, nonzero otherwise.
+ *****************************************************************************/
+int semver_get_pr_span(const semver_t *p_semver,
+                       const char** p2o_str,
+                       size_t *po_len);
+
+/******************************************************************************
+ *  @brief Points at the dotted build meta-data text of the semver, with the
+ *         same conventions as semver_get_pr_span.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @param p2o_str  (OUTPARAM) The build meta-data text.
+ *  @param po_len   (OUTPARAM) Its length.
+ *  @return 0 upon success, nonzero otherwise.
+ *****************************************************************************/
+int semver_get_bmd_span(const semver_t *p_semver,
+                        const char** p2o_str,
+                        size_t *po_len);
+
+/******************************************************************************
+ *  @brief Returns the number of pre-release identifiers of the semver; 0 if
+ *         it has no pre-release.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @return the number of identifiers upon success, negative otherwise.
+ *****************************************************************************/
+int semver_pr_count(const semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Points at one pre-release identifier of the semver, with the
+ *         same conventions as semver_get_pr_span.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @param index    Which identifier, counting from 0.
+ *  @param p2o_id   (OUTPARAM) The identifier.
+ *  @param po_len   (OUTPARAM) Its length.
+ *  @param po_type  (OUTPARAM, optional) Whether it is numeric.
+ *  @return 0 upon success, nonzero otherwise, including when index is out
+ *          of range.
+ *****************************************************************************/
+int semver_pr_at(const semver_t *p_semver,
+                 uint32_t index,
+                 const char** p2o_id,
+                 size_t *po_len,
+                 semver_id_type_t *po_type);
+
 /******************************************************************************
  *  @brief Sets the MAJOR version
  *
@@ -201,6 +356,28 @@ int semver_to_str(const semver_t *p_semver,
                   char** p2o_semver_str,
                   int* po_len);
 
+/******************************************************************************
+ *  @brief Returns the canonical string of the semver, as semver_to_str
+ *         would build it, without allocating a copy.
+ *
+ *         The string is built on first use and kept inside the semver
+ *         until the semver is next modified, so repeated calls are O(1).
+ *         It is NUL terminated, belongs to the semver, and stays valid
+ *         until the semver is modified or released.
+ *
+ *         NOTE: Building the string writes to the semver, so this must not
+ *               race with other use of the same semver.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @param p2o_str  (OUTPARAM) The canonical string.
+ *  @param po_len   (OUTPARAM) Its length, without the terminator.
+ *
+ *  @return 0 if success, positive if invalid, negative if error
+ *****************************************************************************/
+int semver_get_str(semver_t *p_semver,
+                   const char** p2o_str,
+                   size_t *po_len);
+
 /******************************************************************************
  *  @brief Converts a string to a semver_t.
  *
@@ -216,6 +393,53 @@ int semver_str_to_semver(const char* semver_str,
                          uint16_t semver_str_len,
                          semver_t **p2o_semver);
 
+/******************************************************************************
+ *  @brief Converts a string to a semver_t, doing only the work asked for.
+ *
+ *         semver_str_to_semver is this with flags of 0.
+ *
+ *  @param semver_str     The semver string.
+ *  @param semver_str_len The length of the semver string.
+ *  @param flags          Bitwise OR of the SEMVER_* parse flags.
+ *  @param p2o_semver     (OUTPARAM) The resulting semver context.
+ *
+ *  @return 0 if success, positive if invalid, negative if error
+ *****************************************************************************/
+int semver_parse_ex(const char* semver_str,
+                    uint16_t semver_str_len,
+                    uint32_t flags,
+                    semver_t **p2o_semver);
+
+/******************************************************************************
+ *  @brief Parses a string into an existing semver, replacing its contents.
+ *
+ *         The semver's pre-release/build meta-data buffer is reused and
+ *         only grown when the new text does not fit, so parsing one record
+ *         after another into the same semver stops allocating once the
+ *         buffer has grown to fit the longest of them.
+ *
+ *         If the string is invalid the semver is left unchanged. If
+ *         growing the buffer fails the semver is reset.
+ *
+ *  @param p_semver       Pointer to the semver to parse into.
+ *  @param semver_str     The semver string.
+ *  @param semver_str_len The length of the semver string.
+ *
+ *  @return 0 if success, positive if invalid, negative if error
+ *****************************************************************************/
+int semver_parse_into(semver_t *p_semver,
+                      const char* semver_str,
+                      uint16_t semver_str_len);
+
+/******************************************************************************
+ *  @brief Resets a semver to 0.0.0 with no pre-release or build meta-data,
+ *         keeping its buffers for reuse.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @return 0 upon success, nonzero otherwise.
+ *****************************************************************************/
+int semver_reset(semver_t *p_semver);
+
 /******************************************************************************
  *  @brief Compares two semantic versions using the rules of precedence
  *         outlined in semver 2.0.0
@@ -269,12 +493,90 @@ int semver_is_valid(const semver_t *p_semver);
 /******************************************************************************
  *  @brief Determines if a semver string is valid.
  *
+ *         At most len bytes are read; the string need not be NUL terminated,
+ *         so versions can be checked in place inside larger buffers.
+ *
  *  @param p_semver The semver string.
  *  @param len      The length of the semver string.
  *
  *  @return 0 if valid, positive if invalid, negative if error
  *****************************************************************************/
-int semver_str_is_valid(const char* semver_str, uint8_t len);
+int semver_str_is_valid(const char* semver_str, size_t len);
+
+/******************************************************************************
+ *  @brief Determines which of a batch of semver strings are valid.
+ *
+ *         Gives the same answers as semver_str_is_valid, but steps several
+ *         strings through the validator at once, which is considerably
+ *         faster for large batches of short strings.
+ *
+ *  @param strs      The semver strings. A NULL string is invalid.
+ *  @param lens      The lengths of the semver strings.
+ *  @param n         The number of strings.
+ *  @param po_status Receives n entries: 0 if valid, 1 if invalid.
+ *
+ *  @return 0 on success, negative if error
+ *****************************************************************************/
+int semver_validate_many(const char* const* strs,
+                         const size_t* lens,
+                         size_t n,
+                         uint8_t *po_status);
+
+/******************************************************************************
+ *  @brief Increments the MAJOR version in place, resetting MINOR and PATCH.
+ *
+ *         A pre-release of X.0.0 is finalized instead, as X.0.0 is already
+ *         the next major release. Pre-release and build meta-data are always
+ *         dropped.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @return 0 upon success, nonzero otherwise (including overflow).
+ *****************************************************************************/
+int semver_bump_major(semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Increments the MINOR version in place, resetting PATCH.
+ *
+ *         A pre-release of X.Y.0 is finalized instead. Pre-release and build
+ *         meta-data are always dropped.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @return 0 upon success, nonzero otherwise (including overflow).
+ *****************************************************************************/
+int semver_bump_minor(semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Increments the PATCH version in place.
+ *
+ *         A pre-release of X.Y.Z is finalized instead. Pre-release and build
+ *         meta-data are always dropped.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @return 0 upon success, nonzero otherwise (including overflow).
+ *****************************************************************************/
+int semver_bump_patch(semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Increments the pre-release in place, e.g. rc.3 -> rc.4.
+ *
+ *         If the last identifier is numeric it is incremented, reusing its
+ *         storage unless it gains a digit. Otherwise a new ".0" identifier
+ *         is appended (alpha -> alpha.0). Build meta-data is dropped.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @return 0 upon success, nonzero otherwise (including when the semver has
+ *          no pre-release to bump).
+ *****************************************************************************/
+int semver_bump_prerelease(semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Strips the pre-release and build meta-data in place, turning e.g.
+ *         1.2.3-rc.9+b.7 into the release 1.2.3.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @return 0 upon success, nonzero otherwise.
+ *****************************************************************************/
+int semver_finalize(semver_t *p_semver);
 
 /******************************************************************************
  * "Private" definitions, do me a SOLID and don't poke this stuff directly. :)
@@ -285,11 +587,24 @@ struct semver_
     uint32_t minor;
     uint32_t patch;
 
-    char** pr_identifiers;
-    uint16_t num_pr_identifiers;
-
-    char* bmd_str;
-    uint16_t bmd_str_len;
+    /* The pre-release and build meta-data share one buffer, laid out as
+     * "<pre-release>\0<build meta-data>\0". Pre-release identifiers are
+     * not split out; they are walked straight off the text when needed.
+     * A length of 0 means the component is absent.
+     *
+     * Short texts live in inline_tail and tail is NULL. Longer ones spill
+     * to a heap buffer of tail_cap bytes. A non-NULL tail with a tail_cap
+     * of 0 is borrowed from the parsed string (SEMVER_NO_COPY). Nothing
+     * points into the struct itself, so semvers may be copied by value.
+     *
+     * Once semver_get_str has been called, the canonical string follows
+     * in the same buffer, "<pre-release>\0<build meta-data>\0<string>\0",
+     * and str_len is its length. Every change sets str_len back to 0. */
+    uint32_t tail_cap;
+    uint16_t pr_len;
+    uint16_t bmd_len;
+    uint32_t str_len;
+    char* tail;
+    char inline_tail[SEMVER_INLINE_TAIL_LEN];
  };
-
 #endif /* _semver_h_ */
@@ -0,0 +1,124 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_batch_h_
+#define _semver_batch_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_batch.h
+ *
+ * @brief Bulk parsing of newline delimited version lists into columnar
+ *        (structure of arrays) form.
+ *
+ *        Record i of a batch is line i of the input. Lines may end in "\n"
+ *        or "\r\n"; a trailing newline at the end of the buffer does not
+ *        start an extra record. Lines which are not valid versions are kept
+ *        (so that indices line up with the input) and flagged invalid.
+ *
+ *        The pre-release and build meta-data columns are spans into the
+ *        input buffer, which must therefore outlive the batch.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * #defines
+ ******************************************************************************/
+/* Lines longer than this are reported as invalid; the span columns are
+ * 16 bits wide. */
+#define SEMVER_BATCH_MAX_LINE_LEN UINT16_MAX
+
+/* Buffers are never split into chunks smaller than this. */
+#define SEMVER_BATCH_MIN_CHUNK_LEN (64*1024)
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+typedef struct semver_batch_
+{
+    size_t count;
+
+    uint32_t *major;
+    uint32_t *minor;
+    uint32_t *patch;
+
+    /* 0 if record i is a valid version, nonzero otherwise. */
+    uint8_t *status;
+
+    /* Offset of the line in the input buffer, and its length. */
+    size_t *line_off;
+    uint16_t *line_len;
+
+    /* Pre-release and build meta-data, relative to the line start.
+     * A length of 0 means the component is absent. */
+    uint16_t *pr_off;
+    uint16_t *pr_len;
+    uint16_t *bmd_off;
+    uint16_t *bmd_len;
+} semver_batch_t;
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Parses every line of buf on the calling thread.
+ *
+ *  @param buf         The newline delimited versions.
+ *  @param len         The length of buf in bytes.
+ *  @param p2o_batch   (OUTPARAM) The parsed batch.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_batch_parse(const char* buf,
+                       size_t len,
+                       semver_batch_t **p2o_batch);
+
+/******************************************************************************
+ *  @brief Parses every line of buf using a pool of worker threads.
+ *
+ *         The buffer is split at line boundaries into one chunk per worker.
+ *         Each worker first counts its records, then parses them straight
+ *         into its own slice of the output columns, so the result is in
+ *         input order without a merge pass.
+ *
+ *  @param buf         The newline delimited versions.
+ *  @param len         The length of buf in bytes.
+ *  @param num_threads Number of workers, 0 for one per online CPU.
+ *  @param p2o_batch   (OUTPARAM) The parsed batch.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_batch_parse_parallel(const char* buf,
+                                size_t len,
+                                uint32_t num_threads,
+                                semver_batch_t **p2o_batch);
+
+/******************************************************************************
+ *  @brief Destroys a batch.
+ *
+ *  @param po_batch Pointer to the batch to be destroyed.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_batch_destroy(semver_batch_t *po_batch);
+
+#endif /* _semver_batch_h_ */
@@ -0,0 +1,130 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_cache_h_
+#define _semver_cache_h_
+
+#include <stdint.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_cache.h
+ *
+ * @brief A bounded, thread-safe parse cache which sits in front of
+ *        semver_str_to_semver. Each distinct version string is parsed once
+ *        and interned as a frozen semver (see semver_freeze); repeat lookups
+ *        of the same bytes return the very same pointer.
+ *
+ *        Entries are evicted with the CLOCK (second chance) policy once the
+ *        cache reaches its capacity. Every semver handed out carries its own
+ *        reference, so it stays valid until it is released, even if it is
+ *        evicted or the cache is destroyed in the meantime.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * #defines
+ ******************************************************************************/
+/* Number of independently locked shards the cache is split into. */
+#define SEMVER_CACHE_NUM_SHARDS 16
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+struct semver_cache_;
+typedef struct semver_cache_ semver_cache_t;
+
+typedef struct semver_cache_stats_
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint32_t num_entries;
+} semver_cache_stats_t;
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Creates a parse cache holding at most (roughly) capacity versions.
+ *
+ *  @param p2o_cache (OUTPARAM) The newly created cache.
+ *  @param capacity  Maximum number of interned versions, must be nonzero.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_cache_create(semver_cache_t **p2o_cache, uint32_t capacity);
+
+/******************************************************************************
+ *  @brief Destroys a parse cache.
+ *
+ *         Semvers obtained from the cache and not yet released stay valid;
+ *         release them with semver_unref afterwards.
+ *
+ *  @param po_cache Pointer to the cache to be destroyed.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_cache_destroy(semver_cache_t *po_cache);
+
+/******************************************************************************
+ *  @brief Looks up a version string, parsing and interning it on a miss.
+ *
+ *         Accepts exactly the strings semver_str_to_semver accepts. The
+ *         returned semver is frozen and shared with every other caller
+ *         asking for the same bytes, so it must not be modified or
+ *         destroyed. It holds one reference: hand it back with
+ *         semver_cache_release or semver_unref, and take more with
+ *         semver_ref.
+ *
+ *  @param p_cache        Pointer to the cache.
+ *  @param semver_str     The semver string.
+ *  @param semver_str_len The length of the semver string.
+ *  @param p2o_semver     (OUTPARAM) The canonical semver.
+ *
+ *  @return 0 if success, positive if invalid, negative if error
+ *****************************************************************************/
+int semver_cache_get(semver_cache_t *p_cache,
+                     const char* semver_str,
+                     uint16_t semver_str_len,
+                     const semver_t **p2o_semver);
+
+/******************************************************************************
+ *  @brief Releases a semver previously obtained with semver_cache_get.
+ *         The same as semver_unref.
+ *
+ *  @param p_cache  Pointer to the cache.
+ *  @param p_semver The semver to release.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_cache_release(semver_cache_t *p_cache, const semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Reads the cache's hit/miss/eviction counters.
+ *
+ *  @param p_cache  Pointer to the cache.
+ *  @param po_stats (OUTPARAM) The counters.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_cache_get_stats(semver_cache_t *p_cache,
+                           semver_cache_stats_t *po_stats);
+
+#endif /* _semver_cache_h_ */
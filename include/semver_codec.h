@@ -0,0 +1,138 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_codec_h_
+#define _semver_codec_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_codec.h
+ *
+ * @brief A compact binary encoding of semantic versions, for shipping them
+ *        between processes without re-parsing text.
+ *
+ *        All integers are unsigned LEB128 varints. An encoded version is:
+ *
+ *          major, minor, patch
+ *          (num_pr_identifiers << 1) | has_bmd
+ *          for each pre-release identifier, a tag followed by its payload:
+ *            (value << 1) | 0     numeric identifier, no payload
+ *            (length << 1) | 1    alphanumeric identifier, length bytes follow
+ *          if has_bmd: length, then the build meta-data bytes
+ *
+ *        A numeric identifier is only sent as text when its value does not
+ *        fit a tag; the decoder rejects any other all-digit text.
+ *
+ *        "1.2.3" takes 4 bytes, "1.2.3-rc.1" takes 8. Decoding only checks
+ *        identifiers; it never runs the string validator.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * #defines
+ ******************************************************************************/
+/* Longest possible encoding of a single varint. */
+#define SEMVER_VARINT_MAX_LEN 10
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Computes the number of bytes semver_encode will write.
+ *
+ *  @param p_semver Pointer to the semver.
+ *  @param po_size  (OUTPARAM) The encoded size in bytes.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_encoded_size(const semver_t *p_semver, size_t *po_size);
+
+/******************************************************************************
+ *  @brief Encodes a semver into buf.
+ *
+ *  @param p_semver   Pointer to the semver.
+ *  @param buf        The output buffer.
+ *  @param buf_len    The size of the output buffer.
+ *  @param po_written (OUTPARAM) The number of bytes written.
+ *
+ *  @return 0 for success, nonzero otherwise (including buf being too small)
+ *****************************************************************************/
+int semver_encode(const semver_t *p_semver,
+                  uint8_t *buf,
+                  size_t buf_len,
+                  size_t *po_written);
+
+/******************************************************************************
+ *  @brief Decodes one semver from buf.
+ *
+ *         NOTE: The semver outparam is dynamically allocated.
+ *
+ *  @param buf        The encoded bytes.
+ *  @param buf_len    The number of bytes available in buf.
+ *  @param p2o_semver (OUTPARAM) The decoded semver.
+ *  @param po_read    (OUTPARAM) The number of bytes consumed.
+ *
+ *  @return 0 if success, positive if malformed, negative if error
+ *****************************************************************************/
+int semver_decode(const uint8_t *buf,
+                  size_t buf_len,
+                  semver_t **p2o_semver,
+                  size_t *po_read);
+
+/******************************************************************************
+ *  @brief Encodes num_semvers semvers back to back into buf.
+ *
+ *  @param p_semvers   Array of pointers to the semvers.
+ *  @param num_semvers Number of semvers in the array.
+ *  @param buf         The output buffer.
+ *  @param buf_len     The size of the output buffer.
+ *  @param po_written  (OUTPARAM) The number of bytes written.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_encode_many(const semver_t *const *p_semvers,
+                       size_t num_semvers,
+                       uint8_t *buf,
+                       size_t buf_len,
+                       size_t *po_written);
+
+/******************************************************************************
+ *  @brief Decodes num_semvers back to back semvers from buf.
+ *
+ *         On failure no semvers are returned; any decoded so far are
+ *         destroyed.
+ *
+ *  @param buf         The encoded bytes.
+ *  @param buf_len     The number of bytes available in buf.
+ *  @param p2o_semvers (OUTPARAM) Array receiving num_semvers semvers.
+ *  @param num_semvers Number of semvers to decode.
+ *  @param po_read     (OUTPARAM) The number of bytes consumed.
+ *
+ *  @return 0 if success, positive if malformed, negative if error
+ *****************************************************************************/
+int semver_decode_many(const uint8_t *buf,
+                       size_t buf_len,
+                       semver_t **p2o_semvers,
+                       size_t num_semvers,
+                       size_t *po_read);
+
+#endif /* _semver_codec_h_ */
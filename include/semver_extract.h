@@ -0,0 +1,91 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _semver_extract_h_
+#define _semver_extract_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_extract.h
+ *
+ * @brief Finds the versions embedded in free text: log lines, file names,
+ *        changelogs.
+ *
+ *        Text is scanned left to right for the longest run of bytes that
+ *        follows the version grammar; it is a match if it is also a valid
+ *        version, exactly as semver_str_is_valid decides it. A match never
+ *        starts in the middle of a number nor ends in the middle of a number
+ *        or word, and scanning resumes right after it, so matches do not
+ *        overlap. "v1.2.3" yields "1.2.3" and "1.2.3.4" yields "1.2.3", but
+ *        "1.2.00", "1.2.99999999999" and "1.2.3rc1" yield nothing.
+ *
+ *        File extensions are valid pre-release identifiers, so
+ *        "pkg-1.2.3-rc.1.tar.gz" yields "1.2.3-rc.1.tar.gz".
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * #defines
+ ******************************************************************************/
+/* Parse every match, and hand the callback the result. */
+#define SEMVER_EXTRACT_PARSE (1u << 0)
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+typedef struct semver_match_
+{
+    /* The span of the match in the scanned buffer. */
+    size_t off;
+    size_t len;
+
+    /* The parsed match with SEMVER_EXTRACT_PARSE, NULL otherwise. Only
+     * valid for the duration of the callback. */
+    const semver_t *p_semver;
+} semver_match_t;
+
+/* Called once per match, in buffer order. Returning nonzero stops the
+ * scan. */
+typedef int (*semver_extract_cb_t)(void *p_ctx, const semver_match_t *p_match);
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Reports every version found in buf.
+ *
+ *  @param buf      The text to scan. It need not be NUL terminated; a NUL
+ *                  ends any version running into it.
+ *  @param len      The length of buf in bytes.
+ *  @param flags    0, or SEMVER_EXTRACT_PARSE.
+ *  @param callback Called for each match.
+ *  @param p_ctx    Passed through to the callback.
+ *
+ *  @return 0 if the whole buffer was scanned, positive if the callback
+ *          stopped the scan, negative if error
+ *****************************************************************************/
+int semver_extract(const char* buf,
+                   size_t len,
+                   uint32_t flags,
+                   semver_extract_cb_t callback,
+                   void *p_ctx);
+
+#endif /* _semver_extract_h_ */
@@ -0,0 +1,129 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_filter_h_
+#define _semver_filter_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "semver.h"
+#include "semver_batch.h"
+
+/*!*****************************************************************************
+ * @file semver_filter.h
+ *
+ * @brief Filters the columns of a parsed batch against an interval of
+ *        versions, many rows per instruction, producing a bitmask of the
+ *        rows that fall inside it.
+ *
+ *        Major, minor and patch are compared for a block of rows at once;
+ *        only rows whose version core ties with a bound and which carry a
+ *        pre-release themselves fall back to comparing pre-release text one
+ *        row at a time. Invalid rows never match.
+ *
+ *        Comparing against a single pivot version is an interval with one
+ *        bound: ">= 4.2.0" is [4.2.0, none), "== 4.2.0" is [4.2.0, 4.2.0]
+ *        with SEMVER_INTERVAL_HI_INCLUSIVE.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * #defines
+ ******************************************************************************/
+/* By default intervals are [lo, hi): these flags flip either end. */
+#define SEMVER_INTERVAL_LO_EXCLUSIVE (1u << 0)
+#define SEMVER_INTERVAL_HI_INCLUSIVE (1u << 1)
+
+/* The number of 64-bit words in a mask of count rows. */
+#define SEMVER_MASK_WORDS(count) (((count) + 63) / 64)
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+/* One end of an interval. Filled in by semver_interval_compile. */
+typedef struct semver_bound_
+{
+    uint32_t major;
+    uint32_t minor;
+    uint32_t patch;
+    uint16_t pr_len;
+    uint8_t present;
+    uint8_t inclusive;
+    const char* pr;
+} semver_bound_t;
+
+typedef struct semver_interval_
+{
+    semver_bound_t lo;
+    semver_bound_t hi;
+} semver_interval_t;
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Compiles the bounds of an interval for semver_batch_filter.
+ *
+ *         NOTE: The interval refers to the pre-release text of p_lo and
+ *               p_hi, so they must outlive it.
+ *
+ *  @param po_interval (OUTPARAM) The compiled interval.
+ *  @param p_lo        The lower bound, NULL for none.
+ *  @param p_hi        The upper bound, NULL for none.
+ *  @param flags       SEMVER_INTERVAL_* flags, 0 for [lo, hi).
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_interval_compile(semver_interval_t *po_interval,
+                            const semver_t *p_lo,
+                            const semver_t *p_hi,
+                            uint32_t flags);
+
+/******************************************************************************
+ *  @brief Marks the rows of a batch which fall inside an interval.
+ *
+ *  @param p_batch        The batch.
+ *  @param buf            The buffer the batch was parsed from.
+ *  @param p_interval     The compiled interval.
+ *  @param po_mask        (OUTPARAM) SEMVER_MASK_WORDS(count) words; bit
+ *                        i % 64 of word i / 64 is set if row i matches.
+ *  @param po_num_matches (OUTPARAM, optional) The number of matching rows.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_batch_filter(const semver_batch_t *p_batch,
+                        const char* buf,
+                        const semver_interval_t *p_interval,
+                        uint64_t *po_mask,
+                        size_t *po_num_matches);
+
+/******************************************************************************
+ *  @brief Turns a mask into a selection vector: the indices of its set
+ *         bits, in ascending order.
+ *
+ *  @param p_mask  The mask, of SEMVER_MASK_WORDS(count) words.
+ *  @param count   The number of rows the mask covers.
+ *  @param po_rows (OUTPARAM) Room for as many indices as there are set
+ *                 bits.
+ *
+ *  @return The number of indices written.
+ *****************************************************************************/
+size_t semver_mask_to_rows(const uint64_t *p_mask, size_t count, size_t *po_rows);
+
+#endif /* _semver_filter_h_ */
@@ -0,0 +1,189 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_index_h_
+#define _semver_index_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_index.h
+ *
+ * @brief A read-only, memory-mappable index of (package, version) rows.
+ *
+ *        semver_index_write sorts the rows by package name and then by
+ *        version precedence, and lays them out as columns (package, sort
+ *        key, pre-release, build meta-data) over one shared string pool.
+ *        The sort key packs major, minor, patch and whether there is a
+ *        pre-release into two 64-bit words, so searches compare integers and
+ *        only read pre-release text when keys tie.
+ *
+ *        semver_index_open maps such a file and answers lookups and range
+ *        queries straight out of the mapping: no version string is ever
+ *        parsed and no per-row memory is allocated, and every process
+ *        mapping the same file shares its pages.
+ *
+ *        The file is written in host byte order; opening it on a host of the
+ *        other endianness fails.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+struct semver_index_;
+typedef struct semver_index_ semver_index_t;
+
+/* One input row for semver_index_write. */
+typedef struct semver_index_row_
+{
+    const char* pkg;
+    uint16_t pkg_len;
+    const semver_t *p_semver;
+} semver_index_row_t;
+
+/* One row of an open index. The strings point into the mapping, are not NUL
+ * terminated and stay valid until the index is closed. */
+typedef struct semver_index_entry_
+{
+    const char* pkg;
+    uint16_t pkg_len;
+
+    uint32_t major;
+    uint32_t minor;
+    uint32_t patch;
+
+    const char* pr_str;
+    uint16_t pr_str_len;
+
+    const char* bmd_str;
+    uint16_t bmd_str_len;
+} semver_index_entry_t;
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Writes an index file holding the given rows.
+ *
+ *         Rows of equal package and precedence (e.g. differing only in build
+ *         meta-data) keep their input order.
+ *
+ *         The index is written to a temporary file in the same directory
+ *         and renamed over path, so processes that have the old index open
+ *         keep reading it intact; they see the new one once they reopen.
+ *
+ *  @param path     Path of the file to create or replace.
+ *  @param rows     The rows to index.
+ *  @param num_rows The number of rows.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_index_write(const char* path,
+                       const semver_index_row_t *rows,
+                       uint32_t num_rows);
+
+/******************************************************************************
+ *  @brief Maps an index file.
+ *
+ *  @param path      Path of the index file.
+ *  @param p2o_index (OUTPARAM) The opened index.
+ *
+ *  @return 0 if success, positive if the file is not a valid index,
+ *          negative if error
+ *****************************************************************************/
+int semver_index_open(const char* path, semver_index_t **p2o_index);
+
+/******************************************************************************
+ *  @brief Unmaps an index file.
+ *
+ *  @param po_index Pointer to the index to be closed.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_index_close(semver_index_t *po_index);
+
+/******************************************************************************
+ *  @brief Returns the number of rows in the index.
+ *
+ *  @param p_index Pointer to the index.
+ *
+ *  @return number of rows, 0 if p_index is NULL
+ *****************************************************************************/
+uint32_t semver_index_num_rows(const semver_index_t *p_index);
+
+/******************************************************************************
+ *  @brief Reads one row of the index.
+ *
+ *  @param p_index  Pointer to the index.
+ *  @param row      Row number, in sorted order.
+ *  @param po_entry (OUTPARAM) The row.
+ *
+ *  @return 0 for success, nonzero otherwise (including a corrupt row)
+ *****************************************************************************/
+int semver_index_get(const semver_index_t *p_index,
+                     uint32_t row,
+                     semver_index_entry_t *po_entry);
+
+/******************************************************************************
+ *  @brief Finds the first row of a package whose version has the same
+ *         precedence as p_semver.
+ *
+ *  @param p_index  Pointer to the index.
+ *  @param pkg      The package name.
+ *  @param pkg_len  The length of the package name.
+ *  @param p_semver The version to look for.
+ *  @param po_row   (OUTPARAM) The matching row.
+ *
+ *  @return 0 if found, positive if not found, negative if error
+ *****************************************************************************/
+int semver_index_lookup(const semver_index_t *p_index,
+                        const char* pkg,
+                        uint16_t pkg_len,
+                        const semver_t *p_semver,
+                        uint32_t *po_row);
+
+/******************************************************************************
+ *  @brief Finds the rows of a package with p_lo <= version < p_hi.
+ *
+ *         Either bound may be NULL to leave that side open. The matching
+ *         rows are [*po_first, *po_end); the range is empty if they are
+ *         equal.
+ *
+ *  @param p_index  Pointer to the index.
+ *  @param pkg      The package name.
+ *  @param pkg_len  The length of the package name.
+ *  @param p_lo     Inclusive lower bound, or NULL.
+ *  @param p_hi     Exclusive upper bound, or NULL.
+ *  @param po_first (OUTPARAM) The first matching row.
+ *  @param po_end   (OUTPARAM) One past the last matching row.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_index_range(const semver_index_t *p_index,
+                       const char* pkg,
+                       uint16_t pkg_len,
+                       const semver_t *p_lo,
+                       const semver_t *p_hi,
+                       uint32_t *po_first,
+                       uint32_t *po_end);
+
+#endif /* _semver_index_h_ */
@@ -0,0 +1,139 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_registry_h_
+#define _semver_registry_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_registry.h
+ *
+ * @brief A concurrent map from package name to the newest version reported
+ *        for it, for fleets that report versions continuously.
+ *
+ *        Reports and lookups never lock. A report that is not newer than
+ *        what the package already has costs a hash lookup and one 64-bit
+ *        compare; a newer one is published with a single compare-and-swap.
+ *
+ *        Build meta-data does not take part in precedence: a version that
+ *        only differs from the latest in it does not replace it.
+ *
+ *        Versions handed out stay valid until the registry is destroyed;
+ *        take a reference with semver_ref to keep one for longer. Packages
+ *        are never removed, and the versions a package moves past are kept
+ *        until the registry is destroyed.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+struct semver_registry_;
+typedef struct semver_registry_ semver_registry_t;
+
+typedef struct semver_registry_entry_
+{
+    const char* package;
+    size_t package_len;
+    const semver_t *p_latest;
+} semver_registry_entry_t;
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Creates an empty registry.
+ *
+ *  @param p2o_registry (OUTPARAM) The newly created registry.
+ *  @param capacity     Expected number of packages, must be nonzero. More
+ *                      fit, but lookups slow down beyond it.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_registry_create(semver_registry_t **p2o_registry, uint32_t capacity);
+
+/******************************************************************************
+ *  @brief Destroys a registry and every version it holds.
+ *
+ *         NOTE: Must not run concurrently with any other call on the
+ *               registry.
+ *
+ *  @param po_registry Pointer to the registry to be destroyed.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_registry_destroy(semver_registry_t *po_registry);
+
+/******************************************************************************
+ *  @brief Reports a version of a package, which becomes the package's
+ *         latest if it is newer than the one it has.
+ *
+ *  @param p_registry  Pointer to the registry.
+ *  @param package     The package name; any bytes.
+ *  @param package_len The length of the package name.
+ *  @param p_semver    The version; the registry keeps a frozen copy of it.
+ *
+ *  @return 0 if p_semver became the latest, positive if the package
+ *          already had a version at least as new, negative if error
+ *****************************************************************************/
+int semver_registry_report(semver_registry_t *p_registry,
+                           const char* package,
+                           size_t package_len,
+                           const semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Looks up the newest version reported for a package.
+ *
+ *  @param p_registry  Pointer to the registry.
+ *  @param package     The package name.
+ *  @param package_len The length of the package name.
+ *  @param p2o_latest  (OUTPARAM) The newest version.
+ *
+ *  @return 0 if found, positive if the package is unknown, negative if
+ *          error
+ *****************************************************************************/
+int semver_registry_latest(semver_registry_t *p_registry,
+                           const char* package,
+                           size_t package_len,
+                           const semver_t **p2o_latest);
+
+/******************************************************************************
+ *  @brief Copies out every package and its newest version, to be iterated
+ *         at leisure while reports carry on.
+ *
+ *         Packages are copied one at a time: each version is one its
+ *         package held during the call, and none is older than a version
+ *         reported before the call began.
+ *
+ *  NOTE: The entries outparam is dynamically allocated; free it with free.
+ *
+ *  @param p_registry     Pointer to the registry.
+ *  @param p2o_entries    (OUTPARAM) The packages, in no particular order.
+ *  @param po_num_entries (OUTPARAM) The number of packages.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_registry_snapshot(semver_registry_t *p_registry,
+                             semver_registry_entry_t **p2o_entries,
+                             size_t *po_num_entries);
+
+#endif /* _semver_registry_h_ */
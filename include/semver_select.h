@@ -0,0 +1,197 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_select_h_
+#define _semver_select_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "semver.h"
+#include "semver_batch.h"
+
+/*!*****************************************************************************
+ * @file semver_select.h
+ *
+ * @brief Picks the newest or oldest versions out of many without sorting
+ *        them: over arrays of semver_t, over the columns of a parsed batch,
+ *        or over versions arriving one at a time.
+ *
+ *        Versions are ranked by precedence. Pre-release text is only looked
+ *        at when major, minor and patch tie. Among versions of equal
+ *        precedence the one that comes first ranks highest, so results are
+ *        stable.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+/* The k newest of a stream of versions. Treat the members as private. */
+typedef struct semver_top_k_
+{
+    size_t k;
+    size_t num;
+    uint64_t next_seq;
+
+    /* Slot i holds a frozen copy of a kept version and when it arrived. */
+    const semver_t **slots;
+    uint64_t *seqs;
+
+    /* A min-heap of slots, the lowest ranked kept version on top. */
+    size_t *heap;
+    size_t *scratch;
+} semver_top_k_t;
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Finds the version of highest precedence in an array.
+ *
+ *  @param p_semvers The versions.
+ *  @param num       The number of versions.
+ *  @param po_index  (OUTPARAM) The index of the newest version.
+ *
+ *  @return 0 if success, positive if num is 0, negative if error
+ *****************************************************************************/
+int semver_max(const semver_t *p_semvers, size_t num, size_t *po_index);
+
+/******************************************************************************
+ *  @brief Finds the version of lowest precedence in an array.
+ *
+ *  @param p_semvers The versions.
+ *  @param num       The number of versions.
+ *  @param po_index  (OUTPARAM) The index of the oldest version.
+ *
+ *  @return 0 if success, positive if num is 0, negative if error
+ *****************************************************************************/
+int semver_min(const semver_t *p_semvers, size_t num, size_t *po_index);
+
+/******************************************************************************
+ *  @brief Finds the k versions of highest precedence in an array, with a
+ *         bounded heap: O(num log k).
+ *
+ *  @param p_semvers  The versions.
+ *  @param num        The number of versions.
+ *  @param k          The number of versions wanted.
+ *  @param po_indices (OUTPARAM) Room for k indices; filled in newest first.
+ *  @param po_num     (OUTPARAM) The number of indices, the lesser of k and
+ *                    num.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_top_k(const semver_t *p_semvers,
+                 size_t num,
+                 size_t k,
+                 size_t *po_indices,
+                 size_t *po_num);
+
+/******************************************************************************
+ *  @brief Finds the valid row of highest precedence in a batch. Major,
+ *         minor and patch are compared a vector of rows at a time.
+ *
+ *  @param p_batch The batch.
+ *  @param buf     The buffer the batch was parsed from.
+ *  @param po_row  (OUTPARAM) The newest row.
+ *
+ *  @return 0 if success, positive if there are no valid rows, negative if
+ *          error
+ *****************************************************************************/
+int semver_batch_max(const semver_batch_t *p_batch, const char* buf, size_t *po_row);
+
+/******************************************************************************
+ *  @brief Finds the valid row of lowest precedence in a batch, the same way
+ *         semver_batch_max does.
+ *
+ *  @param p_batch The batch.
+ *  @param buf     The buffer the batch was parsed from.
+ *  @param po_row  (OUTPARAM) The oldest row.
+ *
+ *  @return 0 if success, positive if there are no valid rows, negative if
+ *          error
+ *****************************************************************************/
+int semver_batch_min(const semver_batch_t *p_batch, const char* buf, size_t *po_row);
+
+/******************************************************************************
+ *  @brief Finds the k valid rows of highest precedence in a batch.
+ *
+ *  @param p_batch The batch.
+ *  @param buf     The buffer the batch was parsed from.
+ *  @param k       The number of rows wanted.
+ *  @param po_rows (OUTPARAM) Room for k rows; filled in newest first.
+ *  @param po_num  (OUTPARAM) The number of rows, the lesser of k and the
+ *                 number of valid rows.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_batch_top_k(const semver_batch_t *p_batch,
+                       const char* buf,
+                       size_t k,
+                       size_t *po_rows,
+                       size_t *po_num);
+
+/******************************************************************************
+ *  @brief Prepares to keep the k newest of a stream of versions.
+ *
+ *  @param po_top_k (OUTPARAM) The selection.
+ *  @param k        The number of versions to keep, must be nonzero.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_top_k_init(semver_top_k_t *po_top_k, size_t k);
+
+/******************************************************************************
+ *  @brief Frees a selection and drops its references to the kept versions.
+ *
+ *  @param po_top_k The selection.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_top_k_fini(semver_top_k_t *po_top_k);
+
+/******************************************************************************
+ *  @brief Offers the next version of the stream. Only versions which make
+ *         it into the k newest so far are copied.
+ *
+ *  @param p_top_k  The selection.
+ *  @param p_semver The version; it need not outlive the call.
+ *
+ *  @return 0 if kept, positive if not, negative if error
+ *****************************************************************************/
+int semver_top_k_push(semver_top_k_t *p_top_k, const semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Reads out the k newest versions so far, newest first. The stream
+ *         may carry on afterwards.
+ *
+ *         The versions are frozen (see semver_freeze) and stay valid until
+ *         they are pushed out or the selection is freed; take a reference
+ *         with semver_ref to keep one for longer.
+ *
+ *  @param p_top_k     The selection.
+ *  @param po_semvers  (OUTPARAM) Room for k versions.
+ *  @param po_num      (OUTPARAM) The number of versions.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_top_k_result(semver_top_k_t *p_top_k,
+                        const semver_t **po_semvers,
+                        size_t *po_num);
+
+#endif /* _semver_select_h_ */
@@ -0,0 +1,161 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_set_h_
+#define _semver_set_h_
+
+#include <stddef.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_set.h
+ *
+ * @brief A concurrent ordered set of versions, for registries where many
+ *        threads publish versions while others look them up.
+ *
+ *        The set is a skip list ordered by semver precedence. Inserts are
+ *        lock-free; lookups and range scans are wait-free, never retrying
+ *        or blocking however many inserts run alongside them. Versions are
+ *        never removed until the set is destroyed.
+ *
+ *        Build meta-data does not take part in precedence, so 1.0.0+a and
+ *        1.0.0+b are the same element; whichever is inserted first is kept.
+ *
+ *        The set stores frozen copies (see semver_freeze). A semver handed
+ *        out by a lookup stays valid until the set is destroyed; take a
+ *        reference with semver_ref to keep it for longer.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+struct semver_set_;
+typedef struct semver_set_ semver_set_t;
+
+/* Called for each version of a range scan, in ascending order. A nonzero
+ * return value stops the scan. */
+typedef int (*semver_set_cb_t)(void *p_ctx, const semver_t *p_semver);
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Creates an empty set.
+ *
+ *  @param p2o_set (OUTPARAM) The newly created set.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_set_create(semver_set_t **p2o_set);
+
+/******************************************************************************
+ *  @brief Destroys a set and drops its references to the versions in it.
+ *
+ *         NOTE: Must not run concurrently with any other call on the set.
+ *
+ *  @param po_set Pointer to the set to be destroyed.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_set_destroy(semver_set_t *po_set);
+
+/******************************************************************************
+ *  @brief Adds a version to the set. Safe to call concurrently with every
+ *         other call but semver_set_destroy.
+ *
+ *  @param p_set    Pointer to the set.
+ *  @param p_semver The version; the set keeps a frozen copy of it.
+ *
+ *  @return 0 if inserted, positive if a version of equal precedence was
+ *          already present, negative if error
+ *****************************************************************************/
+int semver_set_insert(semver_set_t *p_set, const semver_t *p_semver);
+
+/******************************************************************************
+ *  @brief Finds the version of equal precedence to p_semver.
+ *
+ *  @param p_set     Pointer to the set.
+ *  @param p_semver  The version to look for.
+ *  @param p2o_found (OUTPARAM) The version in the set.
+ *
+ *  @return 0 if found, positive if there is none, negative if error
+ *****************************************************************************/
+int semver_set_find(semver_set_t *p_set,
+                    const semver_t *p_semver,
+                    const semver_t **p2o_found);
+
+/******************************************************************************
+ *  @brief Finds the greatest version which does not follow p_semver.
+ *
+ *  @param p_set     Pointer to the set.
+ *  @param p_semver  The version to look for.
+ *  @param p2o_found (OUTPARAM) The version in the set.
+ *
+ *  @return 0 if found, positive if there is none, negative if error
+ *****************************************************************************/
+int semver_set_floor(semver_set_t *p_set,
+                     const semver_t *p_semver,
+                     const semver_t **p2o_found);
+
+/******************************************************************************
+ *  @brief Finds the least version which does not precede p_semver.
+ *
+ *  @param p_set     Pointer to the set.
+ *  @param p_semver  The version to look for.
+ *  @param p2o_found (OUTPARAM) The version in the set.
+ *
+ *  @return 0 if found, positive if there is none, negative if error
+ *****************************************************************************/
+int semver_set_ceiling(semver_set_t *p_set,
+                       const semver_t *p_semver,
+                       const semver_t **p2o_found);
+
+/******************************************************************************
+ *  @brief Calls callback for each version in [p_lo, p_hi), in ascending
+ *         order.
+ *
+ *         Versions inserted while the scan runs may or may not be visited;
+ *         every version present when it started is.
+ *
+ *  @param p_set    Pointer to the set.
+ *  @param p_lo     The first version of the range, NULL for no lower bound.
+ *  @param p_hi     The version ending the range, NULL for no upper bound.
+ *  @param callback Called for each version in the range.
+ *  @param p_ctx    Passed through to callback.
+ *
+ *  @return 0 if the scan ran to the end, positive if callback stopped it,
+ *          negative if error
+ *****************************************************************************/
+int semver_set_range(semver_set_t *p_set,
+                     const semver_t *p_lo,
+                     const semver_t *p_hi,
+                     semver_set_cb_t callback,
+                     void *p_ctx);
+
+/******************************************************************************
+ *  @brief Returns the number of versions in the set.
+ *
+ *  @param p_set Pointer to the set.
+ *
+ *  @return The number of versions, 0 if p_set is NULL.
+ *****************************************************************************/
+size_t semver_set_size(semver_set_t *p_set);
+
+#endif /* _semver_set_h_ */
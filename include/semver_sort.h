@@ -0,0 +1,110 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_sort_h_
+#define _semver_sort_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_sort.h
+ *
+ * @brief Stable sorting of version arrays by precedence.
+ *
+ *        Arrays of at least SEMVER_SORT_RADIX_MIN versions are radix sorted
+ *        on (major, minor, patch, is-release) without calling a comparator;
+ *        only runs of pre-releases sharing a version core are then sorted
+ *        by comparison. Shorter arrays are merge sorted.
+ *
+ *        Versions of equal precedence keep their input order.
+ *
+ *        The parallel variants sample-sort: splitters drawn from the input
+ *        cut it into buckets of similar size, worker threads scatter the
+ *        keys into them and radix sort whole buckets, and the buckets end
+ *        to end are the result.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * #defines
+ ******************************************************************************/
+/* Below this many versions, a comparison sort beats the fixed cost of the
+ * radix passes. */
+#define SEMVER_SORT_RADIX_MIN 256
+
+/* A parallel sort starts no more workers than leaves each this many
+ * versions; below twice this, it sorts on the calling thread. */
+#define SEMVER_SORT_PARALLEL_MIN (1 << 16)
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Computes the order which sorts an array, leaving it untouched.
+ *
+ *  @param p_semvers The versions.
+ *  @param num       The number of versions.
+ *  @param po_order  (OUTPARAM) num indices: po_order[i] is the index of the
+ *                   i-th lowest version.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_sort_order(const semver_t *p_semvers, size_t num, size_t *po_order);
+
+/******************************************************************************
+ *  @brief Sorts an array in place, lowest precedence first.
+ *
+ *  @param p_semvers The versions.
+ *  @param num       The number of versions.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_sort(semver_t *p_semvers, size_t num);
+
+/******************************************************************************
+ *  @brief Computes the order which sorts an array using a pool of worker
+ *         threads. The order is the same as semver_sort_order's.
+ *
+ *  @param p_semvers   The versions.
+ *  @param num         The number of versions.
+ *  @param num_threads Number of workers, 0 for one per online CPU.
+ *  @param po_order    (OUTPARAM) num indices: po_order[i] is the index of
+ *                     the i-th lowest version.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_sort_order_parallel(const semver_t *p_semvers,
+                               size_t num,
+                               uint32_t num_threads,
+                               size_t *po_order);
+
+/******************************************************************************
+ *  @brief Sorts an array in place using a pool of worker threads.
+ *
+ *  @param p_semvers   The versions.
+ *  @param num         The number of versions.
+ *  @param num_threads Number of workers, 0 for one per online CPU.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_sort_parallel(semver_t *p_semvers, size_t num, uint32_t num_threads);
+
+#endif /* _semver_sort_h_ */
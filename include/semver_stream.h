@@ -0,0 +1,119 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _semver_stream_h_
+#define _semver_stream_h_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_stream.h
+ *
+ * @brief Incremental parsing of versions from a byte stream that arrives in
+ *        arbitrary chunks, such as reads from a socket or a pipe.
+ *
+ *        The stream is a sequence of tokens separated by whitespace (space,
+ *        tab, CR, LF) or NUL; every token is expected to be a version.
+ *        Tokens may be split across chunk boundaries anywhere. Validation
+ *        state is kept between chunks, and only the part of a token seen
+ *        in earlier chunks is ever copied. A token contained in one chunk
+ *        is parsed in place.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * #defines
+ ******************************************************************************/
+/* Longer tokens are counted as invalid. Sizes the carry buffer inside
+ * semver_stream_t; at most UINT16_MAX. */
+#ifndef SEMVER_STREAM_MAX_TOKEN_LEN
+#define SEMVER_STREAM_MAX_TOKEN_LEN 256
+#endif
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+/* Called for every valid token, in stream order. The semver is only valid
+ * for the duration of the call. */
+typedef void (*semver_stream_cb_t)(void *p_ctx, const semver_t *p_semver);
+
+/* Caller-owned storage for a stream; set up with semver_stream_init. */
+typedef struct semver_stream_
+{
+    semver_stream_cb_t callback;
+    void *p_ctx;
+
+    /* Tokens seen so far. */
+    uint64_t num_valid;
+    uint64_t num_invalid;
+
+    /* Everything below is private to the stream. */
+    bool in_token;
+    uint32_t dfa_state;
+    uint32_t token_len;
+    semver_t semver;
+    char carry[SEMVER_STREAM_MAX_TOKEN_LEN];
+} semver_stream_t;
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Initializes a stream.
+ *
+ *  @param po_stream Pointer to the storage for the stream.
+ *  @param callback  Called for every valid token.
+ *  @param p_ctx     Passed through to the callback.
+ *
+ *  @return 0 for success, nonzero otherwise
+ *****************************************************************************/
+int semver_stream_init(semver_stream_t *po_stream,
+                       semver_stream_cb_t callback,
+                       void *p_ctx);
+
+/******************************************************************************
+ *  @brief Feeds the next chunk of the stream. Every token the chunk
+ *         completes is reported before this returns; a token running into
+ *         the end of the chunk is held until a later chunk ends it.
+ *
+ *  @param p_stream Pointer to the stream.
+ *  @param chunk    The next bytes of the stream.
+ *  @param len      The number of bytes.
+ *
+ *  @return 0 for success, negative if error. After an error, the stream
+ *          can only be finished.
+ *****************************************************************************/
+int semver_stream_feed(semver_stream_t *p_stream,
+                       const char* chunk,
+                       size_t len);
+
+/******************************************************************************
+ *  @brief Ends the stream: reports the token held from the last chunk, if
+ *         any, and releases everything the stream owns. The stream may be
+ *         initialized again afterwards.
+ *
+ *  @param p_stream Pointer to the stream.
+ *
+ *  @return 0 for success, negative if error
+ *****************************************************************************/
+int semver_stream_finish(semver_stream_t *p_stream);
+
+#endif /* _semver_stream_h_ */
@@ -19,33 +19,121 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 
 #include "semver.h"
+#include "semver_private.h"
 
 /******************************************************************************
  * Defines
  ******************************************************************************/
-/* For string safety reasons, we limit the max id string length */
-#define MAX_ID_STR_LEN 20
+/* "4294967295.4294967295.4294967295" */
+#define MAX_CORE_STR_LEN (3*10 + 2)
+/* The build meta-data sits right behind the pre-release's terminator. */
+#define BMD_STR(p_semver) (SEMVER_TAIL(p_semver) + (p_semver)->pr_len + 1)
+/* The cached canonical string sits right behind the build meta-data's. */
+#define CACHED_STR(p_semver) (BMD_STR(p_semver) + (p_semver)->bmd_len + 1)
 #define MAX(a,b) (((a)>(b))?(a):(b))
 #define MIN(a,b) (((a)<(b))?(a):(b))
+#define CMP(a,b) (((a)>(b)) - ((a)<(b)))
+/* Strings semver_validate_many walks through the DFA at once. */
+#define SEMVER_VALIDATE_LANES 8
+
+/* The validator engine used for parsing: the re2c switch DFA by default, or
+ * the table-driven one when built with -DSEMVER_TABLE_VALIDATOR. */
+#ifdef SEMVER_TABLE_VALIDATOR
+#define STR_VALIDATOR semver_str_validator_table
+#else
+#define STR_VALIDATOR semver_str_validator
+#endif
 
 /******************************************************************************
  * Typedefs
  ******************************************************************************/
+/* Byte classes of the table-driven validator. */
+typedef enum byte_class_
+{
+    C_OTHER,
+    C_DIGIT,
+    C_ALPHA,
+    C_HYPHEN,
+    C_DOT,
+    C_PLUS,
+    C_END,
+    NUM_BYTE_CLASSES
+} byte_class_t;
+
+/* States of the table-driven validator. At most 32, for the visited-state
+ * mask. */
+typedef enum validator_state_
+{
+    V_ERR = SEMVER_DFA_DEAD,
+    V_START = SEMVER_DFA_START,
+    V_MAJOR,
+    V_MINOR_START,
+    V_MINOR,
+    V_PATCH_START,
+    V_PATCH,
+    V_PR_ID_START,
+    V_PR_ID,
+    V_BMD_ID_START,
+    V_BMD_ID,
+    V_ACCEPT,
+    NUM_VALIDATOR_STATES
+} validator_state_t;
+
+/* A frozen semver and its text, in one allocation. */
+typedef struct frozen_semver_
+{
+    //Must stay the first member: frozen semvers are mapped back to their
+    //block by address.
+    semver_t semver;
+
+    atomic_uint refs;
+    char text[];
+} frozen_semver_t;
 
 /******************************************************************************
  * static function prototypes
  ******************************************************************************/
 static int pre_release_cmp(const semver_t * p_sva, const semver_t *p_svb);
-//static int pre_release_str_cmp(const char* pr_stra, const char* pr_strb);
-static bool is_numeric(const char* str);
-
-static int cmp_numeric(const char* stra, const char* strb);
-static int cmp_lexical(const char* stra, const char* strb);
-static int get_num_identifiers(const char* str, uint16_t str_len);
+static bool is_numeric(const char* str, size_t len);
+
+static int cmp_numeric(const char* stra, size_t len_a,
+                       const char* strb, size_t len_b);
+static int cmp_lexical(const char* stra, size_t len_a,
+                       const char* strb, size_t len_b);
+static size_t next_identifier_len(const char* str, size_t str_len);
+static bool is_digits(const char* str, size_t str_len);
+static uint64_t load8(const char* str);
+static bool all_digits8(uint64_t chunk);
+static uint32_t digits8_value(uint64_t chunk);
+static int parse_core(const char* core, const char* core_end, semver_parts_t *po_parts);
+static bool pr_ids_canonical(const char* pr_str, size_t pr_len);
+static int locate_parts(const char* semver_str,
+                        size_t semver_str_len,
+                        semver_parts_t *po_parts);
+static void validate_lanes(const char* const* strs,
+                           const size_t* lens,
+                           size_t num_lanes,
+                           uint8_t *po_status);
+static size_t format_str(const semver_t *p_semver, char* str);
+static size_t formatted_len(const semver_t *p_semver);
+static size_t decimal_len(uint32_t value);
+static void clear_pr(semver_t *p_semver);
+static void clear_bmd(semver_t *p_semver);
+static int reserve_tail(semver_t *p_semver, uint32_t needed);
+static bool is_borrowed(const semver_t *p_semver);
+static uint32_t tail_capacity(const semver_t *p_semver);
+static int parse_into(semver_t *p_semver,
+                      const char* semver_str,
+                      uint16_t semver_str_len,
+                      uint32_t flags);
+static bool in_tail(const semver_t *p_semver, const char* str);
+static int store_pr(semver_t *p_semver, const char* pr_str, uint16_t pr_len);
+static int store_bmd(semver_t *p_semver, const char* bmd_str, uint16_t bmd_len);
 static int semver_str_validator(const char*  semver_str,
-                         uint16_t semver_str_len,
+                         size_t semver_str_len,
                          bool *po_has_primary,
                          bool *po_has_pre_release,
                          bool *po_has_bmd);
@@ -53,20 +141,137 @@ static int semver_str_validator(const char*  semver_str,
 /******************************************************************************
  * static variables
  ******************************************************************************/
+/* Class of every byte, one argument per class. Shared by g_byte_class and
+ * the rows of g_byte_transitions so that the two cannot drift apart. */
+#define BYTE_CLASS_LAYOUT(_, D, A, H, P, S, E) \
+    E, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0x00 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0x10 */ \
+    _, _, _, _, _, _, _, _, _, _, _, S, _, H, P, _, /* 0x20 */ \
+    D, D, D, D, D, D, D, D, D, D, _, _, _, _, _, _, /* 0x30 */ \
+    _, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A, /* 0x40 */ \
+    A, A, A, A, A, A, A, A, A, A, A, _, _, _, _, _, /* 0x50 */ \
+    _, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A, /* 0x60 */ \
+    A, A, A, A, A, A, A, A, A, A, A, _, _, _, _, _, /* 0x70 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0x80 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0x90 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0xA0 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0xB0 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0xC0 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0xD0 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, /* 0xE0 */ \
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _  /* 0xF0 */
+#define BYTE_ROW(...) BYTE_CLASS_LAYOUT(__VA_ARGS__)
+
+/* Next state of every state for each byte class, in the column order
+ * OTHER, DIGIT, ALPHA, HYPHEN, DOT, PLUS, END. Both V_ERR and V_ACCEPT are
+ * absorbing, so a walk needs no early exit: a NUL ends the string exactly
+ * as it does for the re2c DFA. */
+#define T_ERR(f)          f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR)
+#define T_START(f)        f(V_ERR), f(V_MAJOR), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR)
+#define T_MAJOR(f)        f(V_ERR), f(V_MAJOR), f(V_ERR), f(V_ERR), f(V_MINOR_START), f(V_ERR), f(V_ERR)
+#define T_MINOR_START(f)  f(V_ERR), f(V_MINOR), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR)
+#define T_MINOR(f)        f(V_ERR), f(V_MINOR), f(V_ERR), f(V_ERR), f(V_PATCH_START), f(V_ERR), f(V_ERR)
+#define T_PATCH_START(f)  f(V_ERR), f(V_PATCH), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR), f(V_ERR)
+#define T_PATCH(f)        f(V_ERR), f(V_PATCH), f(V_ERR), f(V_PR_ID_START), f(V_ERR), f(V_BMD_ID_START), f(V_ACCEPT)
+#define T_PR_ID_START(f)  f(V_ERR), f(V_PR_ID), f(V_PR_ID), f(V_PR_ID), f(V_ERR), f(V_ERR), f(V_ERR)
+#define T_PR_ID(f)        f(V_ERR), f(V_PR_ID), f(V_PR_ID), f(V_PR_ID), f(V_PR_ID_START), f(V_BMD_ID_START), f(V_ACCEPT)
+#define T_BMD_ID_START(f) f(V_ERR), f(V_BMD_ID), f(V_BMD_ID), f(V_BMD_ID), f(V_ERR), f(V_ERR), f(V_ERR)
+#define T_BMD_ID(f)       f(V_ERR), f(V_BMD_ID), f(V_BMD_ID), f(V_BMD_ID), f(V_BMD_ID_START), f(V_ERR), f(V_ACCEPT)
+#define T_ACCEPT(f)       f(V_ACCEPT), f(V_ACCEPT), f(V_ACCEPT), f(V_ACCEPT), f(V_ACCEPT), f(V_ACCEPT), f(V_ACCEPT)
+#define ROW(state) ((state) << 3)
+#define STATE(state) (state)
+
+static const uint8_t g_byte_class[256] =
+{
+    BYTE_CLASS_LAYOUT(C_OTHER, C_DIGIT, C_ALPHA, C_HYPHEN, C_DOT, C_PLUS, C_END)
+};
+
+/* Row-major NUM_VALIDATOR_STATES x 8 matrix indexed by byte class. Entries
+ * hold the next state times 8, i.e. the offset of its row, so a step is a
+ * single add and load. */
+static const uint8_t g_transitions[NUM_VALIDATOR_STATES << 3] =
+{
+    [ROW(V_ERR)]          = T_ERR(ROW),
+    [ROW(V_START)]        = T_START(ROW),
+    [ROW(V_MAJOR)]        = T_MAJOR(ROW),
+    [ROW(V_MINOR_START)]  = T_MINOR_START(ROW),
+    [ROW(V_MINOR)]        = T_MINOR(ROW),
+    [ROW(V_PATCH_START)]  = T_PATCH_START(ROW),
+    [ROW(V_PATCH)]        = T_PATCH(ROW),
+    [ROW(V_PR_ID_START)]  = T_PR_ID_START(ROW),
+    [ROW(V_PR_ID)]        = T_PR_ID(ROW),
+    [ROW(V_BMD_ID_START)] = T_BMD_ID_START(ROW),
+    [ROW(V_BMD_ID)]       = T_BMD_ID(ROW),
+    [ROW(V_ACCEPT)]       = T_ACCEPT(ROW),
+};
+
+/* The same DFA indexed by raw byte, with the classes folded in: a step is
+ * one load rather than two, which is what lets several interleaved walks
+ * actually overlap. 3 KiB, so it stays in L1 next to g_transitions. */
+static const uint8_t g_byte_transitions[NUM_VALIDATOR_STATES][256] =
+{
+    [V_ERR]          = { BYTE_ROW(T_ERR(STATE)) },
+    [V_START]        = { BYTE_ROW(T_START(STATE)) },
+    [V_MAJOR]        = { BYTE_ROW(T_MAJOR(STATE)) },
+    [V_MINOR_START]  = { BYTE_ROW(T_MINOR_START(STATE)) },
+    [V_MINOR]        = { BYTE_ROW(T_MINOR(STATE)) },
+    [V_PATCH_START]  = { BYTE_ROW(T_PATCH_START(STATE)) },
+    [V_PATCH]        = { BYTE_ROW(T_PATCH(STATE)) },
+    [V_PR_ID_START]  = { BYTE_ROW(T_PR_ID_START(STATE)) },
+    [V_PR_ID]        = { BYTE_ROW(T_PR_ID(STATE)) },
+    [V_BMD_ID_START] = { BYTE_ROW(T_BMD_ID_START(STATE)) },
+    [V_BMD_ID]       = { BYTE_ROW(T_BMD_ID(STATE)) },
+    [V_ACCEPT]       = { BYTE_ROW(T_ACCEPT(STATE)) },
+};
+#undef BYTE_CLASS_LAYOUT
+#undef BYTE_ROW
+#undef T_ERR
+#undef T_START
+#undef T_MAJOR
+#undef T_MINOR_START
+#undef T_MINOR
+#undef T_PATCH_START
+#undef T_PATCH
+#undef T_PR_ID_START
+#undef T_PR_ID
+#undef T_BMD_ID_START
+#undef T_BMD_ID
+#undef T_ACCEPT
+#undef ROW
+#undef STATE
 
 /******************************************************************************
  * non-static function definitions
  ******************************************************************************/
 int semver_create(semver_t **p2o_semver)
 {
+    semver_t *p_semver;
+
     if(NULL == p2o_semver)
     {
         return 1;
     }
 
-    *p2o_semver = (semver_t*)malloc(sizeof(semver_t));
+    p_semver = (semver_t*)malloc(sizeof(semver_t));
+    if(NULL == p_semver)
+    {
+        return -1;
+    }
+
+    semver_init(p_semver);
+    *p2o_semver = p_semver;
+
+    return 0;
+}
+
+int semver_init(semver_t *po_semver)
+{
+    if(NULL == po_semver)
+    {
+        return 1;
+    }
 
-    memset(*p2o_semver,0,sizeof(semver_t));
+    memset(po_semver, 0, sizeof(semver_t));
 
     return 0;
 }
@@ -78,11 +283,103 @@ int semver_destroy(semver_t *po_semver)
         return 1;
     }
 
+    semver_fini(po_semver);
     free(po_semver);
 
     return 0;
 }
 
+int semver_fini(semver_t *po_semver)
+{
+    if(NULL == po_semver)
+    {
+        return 1;
+    }
+
+    if(!is_borrowed(po_semver))
+    {
+        free(po_semver->tail);
+    }
+    semver_init(po_semver);
+
+    return 0;
+}
+
+int semver_freeze(const semver_t *p_semver, const semver_t **p2o_frozen)
+{
+    frozen_semver_t *p_frozen;
+    uint32_t text_len;
+    char* text;
+
+    if(NULL == p_semver || NULL == p2o_frozen)
+    {
+        return 1;
+    }
+
+    text_len = p_semver->pr_len + 1 + p_semver->bmd_len + 1;
+    p_frozen = (frozen_semver_t*)malloc(sizeof(frozen_semver_t) +
+                                        ((text_len > SEMVER_INLINE_TAIL_LEN)? text_len : 0));
+    if(NULL == p_frozen)
+    {
+        return -1;
+    }
+
+    semver_init(&p_frozen->semver);
+    p_frozen->semver.major = p_semver->major;
+    p_frozen->semver.minor = p_semver->minor;
+    p_frozen->semver.patch = p_semver->patch;
+    p_frozen->semver.pr_len = p_semver->pr_len;
+    p_frozen->semver.bmd_len = p_semver->bmd_len;
+
+    //Text that does not fit inline goes behind the struct. To the rest of
+    //the library it looks borrowed, so nothing ever tries to free it.
+    if(text_len > SEMVER_INLINE_TAIL_LEN)
+    {
+        p_frozen->semver.tail = p_frozen->text;
+    }
+
+    text = SEMVER_TAIL(&p_frozen->semver);
+    memcpy(text, SEMVER_TAIL(p_semver), p_semver->pr_len);
+    text[p_semver->pr_len] = '\0';
+    memcpy(text + p_semver->pr_len + 1, BMD_STR(p_semver), p_semver->bmd_len);
+    text[p_semver->pr_len + 1 + p_semver->bmd_len] = '\0';
+
+    atomic_init(&p_frozen->refs, 1);
+
+    *p2o_frozen = &p_frozen->semver;
+    return 0;
+}
+
+const semver_t* semver_ref(const semver_t *p_frozen)
+{
+    if(NULL != p_frozen)
+    {
+        //Whoever passes the semver on already holds a reference, so no
+        //ordering is needed.
+        atomic_fetch_add_explicit(&((frozen_semver_t*)p_frozen)->refs, 1,
+                                  memory_order_relaxed);
+    }
+
+    return p_frozen;
+}
+
+int semver_unref(const semver_t *p_frozen)
+{
+    frozen_semver_t *p_block = (frozen_semver_t*)p_frozen;
+
+    if(NULL == p_frozen)
+    {
+        return 1;
+    }
+
+    if(1 == atomic_fetch_sub_explicit(&p_block->refs, 1, memory_order_acq_rel))
+    {
+        free(p_block);
+    }
+
+    return 0;
+}
+
 int semver_get_major(const semver_t *p_semver)
 {
     if(NULL == p_semver)
@@ -115,45 +412,26 @@ int semver_get_pr_str(const semver_t *p_semver,
                       char** p2o_pr_str,
                       uint16_t *po_str_len)
 {
-    int i =0;
-    uint16_t res_str_len = 0;
     if(NULL == p_semver || NULL == p2o_pr_str || NULL == po_str_len)
     {
         return 1;
     }
 
-    //Determine the size of the resulting string.
-    for(i =0; i < p_semver->num_pr_identifiers; i++)
-    {
-        res_str_len += strlen(p_semver->pr_identifiers[i]);
-    }
-    if(p_semver->num_pr_identifiers >2)
+    if(0 == p_semver->pr_len)
     {
-        res_str_len += p_semver->num_pr_identifiers -1;
+        *p2o_pr_str = NULL;
+        *po_str_len = 0;
+        return 0;
     }
 
-    *p2o_pr_str = (char*)malloc((res_str_len+1)*sizeof(char));
+    //The identifiers are stored dotted already; just copy them out.
+    *p2o_pr_str = strndup(SEMVER_TAIL(p_semver), p_semver->pr_len);
     if(NULL == *p2o_pr_str)
     {
         return 1;
     }
-    
-    memset(*p2o_pr_str,0,(res_str_len+1)*sizeof(char));
-    *po_str_len = res_str_len;
-
-    for(i=0; i< p_semver->num_pr_identifiers; i++)
-    {
-        strncat(*p2o_pr_str, p_semver->pr_identifiers[i],MAX_ID_STR_LEN);
-        
-        if( p_semver->num_pr_identifiers > 1)
-        {
-            if(i < (p_semver->num_pr_identifiers -1))
-            {
-                strncat(*p2o_pr_str,".",1);
-            }
-        }
-    }
 
+    *po_str_len = p_semver->pr_len;
     return 0;
 }
 
@@ -168,14 +446,111 @@ int semver_get_bmd_str(const semver_t *p_semver,
         return 1;
     }
 
-    if(NULL == p_semver->bmd_str)
+    if(0 == p_semver->bmd_len)
     {
         *p2o_bmd_str = NULL;
+        *po_str_len = 0;
     }
     else
     {
-        *p2o_bmd_str = p_semver->bmd_str;
-        *po_str_len = p_semver->bmd_str_len;
+        //Internal storage, as it always was; not to be freed.
+        *p2o_bmd_str = (char*)BMD_STR(p_semver);
+        *po_str_len = p_semver->bmd_len;
+    }
+
+    return 0;
+}
+
+int semver_get_pr_span(const semver_t *p_semver,
+                       const char** p2o_str,
+                       size_t *po_len)
+{
+    if(NULL == p_semver || NULL == p2o_str || NULL == po_len)
+    {
+        return 1;
+    }
+
+    *p2o_str = (0 != p_semver->pr_len)? SEMVER_TAIL(p_semver) : NULL;
+    *po_len = p_semver->pr_len;
+    return 0;
+}
+
+int semver_get_bmd_span(const semver_t *p_semver,
+                        const char** p2o_str,
+                        size_t *po_len)
+{
+    if(NULL == p_semver || NULL == p2o_str || NULL == po_len)
+    {
+        return 1;
+    }
+
+    *p2o_str = (0 != p_semver->bmd_len)? BMD_STR(p_semver) : NULL;
+    *po_len = p_semver->bmd_len;
+    return 0;
+}
+
+int semver_pr_count(const semver_t *p_semver)
+{
+    const char* pr_str;
+    int count;
+    uint16_t i;
+
+    if(NULL == p_semver)
+    {
+        return -1;
+    }
+
+    if(0 == p_semver->pr_len)
+    {
+        return 0;
+    }
+
+    pr_str = SEMVER_TAIL(p_semver);
+    count = 1;
+    for(i=0;i<p_semver->pr_len;i++)
+    {
+        count += ('.' == pr_str[i]);
+    }
+
+    return count;
+}
+
+int semver_pr_at(const semver_t *p_semver,
+                 uint32_t index,
+                 const char** p2o_id,
+                 size_t *po_len,
+                 semver_id_type_t *po_type)
+{
+    const char* id;
+    const char* pr_end;
+    size_t id_len;
+
+    if(NULL == p_semver || NULL == p2o_id || NULL == po_len ||
+       0 == p_semver->pr_len)
+    {
+        return 1;
+    }
+
+    id = SEMVER_TAIL(p_semver);
+    pr_end = id + p_semver->pr_len;
+    id_len = next_identifier_len(id, pr_end - id);
+
+    //Skip whole identifiers rather than counting dots byte by byte.
+    while(0 != index--)
+    {
+        id += id_len + 1;
+        if(id >= pr_end)
+        {
+            return 1;
+        }
+        id_len = next_identifier_len(id, pr_end - id);
+    }
+
+    *p2o_id = id;
+    *po_len = id_len;
+    if(NULL != po_type)
+    {
+        *po_type = is_digits(id, id_len)? SEMVER_ID_NUMERIC : SEMVER_ID_ALPHANUMERIC;
     }
 
     return 0;
@@ -189,6 +564,7 @@ int semver_set_major(semver_t *p_semver, uint32_t major)
     }
 
     p_semver->major = major;
+    p_semver->str_len = 0;
 
     return 0;
 }
@@ -201,6 +577,7 @@ int semver_set_minor(semver_t *p_semver, uint32_t minor)
     }
 
     p_semver->minor = minor;
+    p_semver->str_len = 0;
     return 0;
 }
 
@@ -212,6 +589,7 @@ int semver_set_patch(semver_t *p_semver, uint32_t patch)
     }
 
     p_semver->patch = patch;
+    p_semver->str_len = 0;
     return 0;
 }
 
@@ -219,10 +597,6 @@ int semver_set_pr_str(semver_t *p_semver,
                       const char* pr_str,
                       uint16_t pr_str_len)
 {
-    int i = 0;
-    char* tokenizer_str = NULL;
-    char* token = NULL;
-
     if(NULL == p_semver || NULL == pr_str)
     {
         return 1;
@@ -230,54 +604,13 @@ int semver_set_pr_str(semver_t *p_semver,
 
     //TODO: CHECK VALIDITY
 
-    tokenizer_str = strndup(pr_str,pr_str_len);
-    if(NULL == tokenizer_str)
-    {
-        return 1;
-    }
-
-    //If there were any previous pr strings, get rid of them.
-    for(i=0;i<p_semver->num_pr_identifiers;i++)
-    {
-        free(p_semver->pr_identifiers[i]);
-    }
-    free(p_semver->pr_identifiers);
-    p_semver->num_pr_identifiers = 0;
-
-    //Create new array of strings to hold pre-release identifiers.
-    p_semver->num_pr_identifiers = get_num_identifiers(pr_str, pr_str_len);
-    if(p_semver->num_pr_identifiers <= 0)
-    {
-        free(tokenizer_str);
-        return 1;
-    }
-
-    p_semver->pr_identifiers = (char**)malloc(p_semver->num_pr_identifiers*sizeof(char*));
-    if(NULL == p_semver->pr_identifiers)
+    pr_str_len = strnlen(pr_str, pr_str_len);
+    if(0 == pr_str_len)
     {
-        free(tokenizer_str);
         return 1;
     }
-    
-    for(i=0;i<p_semver->num_pr_identifiers;i++)
-    {
-        if(0 == i)
-        {
-            token = strtok(tokenizer_str,".");
-        }
-        else
-        {
-            token = strtok(NULL,".");
-        }
-        
-        if(NULL != token)
-        {
-            p_semver->pr_identifiers[i] = strndup(token, MAX_ID_STR_LEN);
-        }
-    }
 
-    free(tokenizer_str);
-    return 0;
+    return store_pr(p_semver, pr_str, pr_str_len);
 }
 
 int semver_set_bmd_str(semver_t *p_semver,
@@ -291,183 +624,171 @@ int semver_set_bmd_str(semver_t *p_semver,
 
     //TODO: CHECK VALIDITY
 
-    p_semver->bmd_str = strndup(bmd_str, bmd_str_len);
-    if(NULL == p_semver->bmd_str)
+    bmd_str_len = strnlen(bmd_str, bmd_str_len);
+    if(0 == bmd_str_len)
     {
         return 1;
     }
 
-    p_semver->bmd_str_len = strlen(p_semver->bmd_str);
-
-    return 0;
+    return store_bmd(p_semver, bmd_str, bmd_str_len);
 }
 
 int semver_to_str(const semver_t *p_semver,
                   char** p2o_semver_str,
                   int* po_len)
 {
-    int result_str_len = 0;
     char *result_str = NULL;
-    int i = 0;
     
     if(NULL == p_semver || NULL == p2o_semver_str || NULL == po_len)
     {
         return 1;
     }
     
-    result_str_len += 3*10; //First 3 digits.
-    result_str_len += 3;    //potentially 3 dots
-    
-    //Bytes for extra identifiers
-    for(i=0; i<p_semver->num_pr_identifiers; i++)
+    result_str = (char*)malloc(MAX_CORE_STR_LEN + 1 +
+                               p_semver->pr_len + 1 +
+                               p_semver->bmd_len + 1);
+    if(NULL == result_str)
     {
-        result_str_len += strlen(p_semver->pr_identifiers[i]);
+        return 1;
     }
     
-    if(p_semver->num_pr_identifiers)
-    {
-        //1 byte for the hyphen
-        result_str_len += 1;
-    }
+    *po_len = format_str(p_semver, result_str);
+    *p2o_semver_str = result_str;
     
-    if(p_semver->num_pr_identifiers > 1)
+    return 0;
+}
+
+int semver_get_str(semver_t *p_semver,
+                   const char** p2o_str,
+                   size_t *po_len)
+{
+    if(NULL == p_semver || NULL == p2o_str || NULL == po_len)
     {
-        //1 byte for each dot
-        result_str_len += p_semver->num_pr_identifiers -1;
+        return 1;
     }
     
-    if(NULL != p_semver->bmd_str)
+    if(0 == p_semver->str_len)
     {
-        result_str_len += 1; //For the '+'
-        result_str_len += strlen(p_semver->bmd_str);
+        //Make room behind the build meta-data; this also takes a private
+        //copy of borrowed text, which must not be written to. Exactly as
+        //much as needed, so that short versions stay in the inline tail.
+        if(0 != reserve_tail(p_semver,
+                             p_semver->pr_len + 1 + p_semver->bmd_len + 1 +
+                             formatted_len(p_semver) + 1))
+        {
+            return -1;
+        }
+        
+        //The pre-release and build meta-data are copied from just in front.
+        p_semver->str_len = format_str(p_semver, CACHED_STR(p_semver));
     }
     
-    result_str_len += 1;    //1 NULL byte
-    
-    result_str = (char*)malloc(result_str_len*sizeof(char));
-    
-    //TODO: Check validity.
-    
-    //Add the primary components
-    snprintf(result_str,
-             result_str_len,
-             "%d.%d.%d",
-             p_semver->major,
-             p_semver->minor,
-             p_semver->patch);
+    *p2o_str = CACHED_STR(p_semver);
+    *po_len = p_semver->str_len;
+    return 0;
+}
+
+int semver_str_to_semver(const char* semver_str,
+                         uint16_t semver_str_len,
+                         semver_t **p2o_semver)
+{
+    return semver_parse_ex(semver_str, semver_str_len, 0, p2o_semver);
+}
+
+int semver_parse_ex(const char* semver_str,
+                    uint16_t semver_str_len,
+                    uint32_t flags,
+                    semver_t **p2o_semver)
+{
+    semver_t *p_semver = NULL;
+    int result;
     
-    if(p_semver->num_pr_identifiers)
+    if(NULL == semver_str ||
+       (NULL == p2o_semver && !(flags & SEMVER_VALIDATE_ONLY)))
     {
-        strncat(result_str, "-", 1);
+        return 1;
     }
     
-    //Add thre pre-release components
-    for(i=0; i<p_semver->num_pr_identifiers; i++)
+    if(flags & SEMVER_VALIDATE_ONLY)
     {
-        strncat(result_str,
-                p_semver->pr_identifiers[i],
-                strlen(p_semver->pr_identifiers[i]));
-        if(i<p_semver->num_pr_identifiers -1)
-        {
-            strncat(result_str, ".", 1);
-        }
+        return parse_into(NULL, semver_str, semver_str_len, flags);
     }
     
-    //Add the build meta-data
-    if(NULL != p_semver->bmd_str)
+    if(0 != semver_create(&p_semver))
     {
-        strncat(result_str, "+", 1);
-        strncat(result_str,
-                p_semver->bmd_str,
-                strlen(p_semver->bmd_str));
+        return -1;
     }
     
-    *p2o_semver_str = result_str;
-    *po_len = result_str_len;
+    result = parse_into(p_semver, semver_str, semver_str_len, flags);
+    if(0 != result)
+    {
+        semver_destroy(p_semver);
+        return result;
+    }
     
+    *p2o_semver = p_semver;
     return 0;
 }
 
-int semver_str_to_semver(const char* semver_str,
-                         uint16_t semver_str_len,
-                         semver_t **p2o_semver)
+int semver_parse_into(semver_t *p_semver,
+                      const char* semver_str,
+                      uint16_t semver_str_len)
 {
-    semver_t *p_semver = NULL;
-    bool has_primary = 0;
-    bool has_pr = 0;
-    bool has_bmd = 0;
-    
-    if(NULL == semver_str || NULL == p2o_semver)
+    if(NULL == p_semver || NULL == semver_str)
     {
         return 1;
     }
     
-    if(0 != semver_str_validator(semver_str,
-                                 semver_str_len,
-                                 &has_primary,
-                                 &has_pr, &has_bmd))
+    return parse_into(p_semver, semver_str, semver_str_len, 0);
+}
+
+int semver_reset(semver_t *p_semver)
+{
+    if(NULL == p_semver)
     {
         return 1;
     }
     
-    *p2o_semver = (semver_t*)malloc(sizeof(semver_t));
-    memset(*p2o_semver, 0, sizeof(semver_t));
-    p_semver = *p2o_semver;
+    p_semver->major = 0;
+    p_semver->minor = 0;
+    p_semver->patch = 0;
+    p_semver->pr_len = 0;
+    p_semver->bmd_len = 0;
+    p_semver->str_len = 0;
     
-    if(0 != p_semver->num_pr_identifiers)
+    //An owned buffer is kept for the next parse; a borrowed one is dropped
+    //in favour of the inline one.
+    if(is_borrowed(p_semver))
     {
-        int i;
-        for(i=0;i<p_semver->num_pr_identifiers;i++)
-        {
-            free(p_semver->pr_identifiers[i]);
-        }
-        free(p_semver->pr_identifiers);
-        p_semver->pr_identifiers = NULL;
-        
+        p_semver->tail = NULL;
     }
     
-    if(has_primary)
+    return 0;
+}
+
+int semver_parse_parts(const char* semver_str,
+                       size_t semver_str_len,
+                       semver_parts_t *po_parts)
+{
+    if(NULL == semver_str || NULL == po_parts)
     {
-        sscanf(semver_str, "%d.%d.%d", &p_semver->major,
-                                       &p_semver->minor,
-                                       &p_semver->patch);
+        return -1;
     }
     
-    if(has_pr)
+    //The string ends at len or its first NUL, whichever comes first, and
+    //offsets into it must fit the parts.
+    semver_str_len = strnlen(semver_str, semver_str_len);
+    if(semver_str_len > UINT16_MAX)
     {
-        char* end = strrchr(semver_str, '+'); //Finds either the end, or the '+"
-        char* curr_tup_start = strrchr(semver_str, '-')+1;
-        char* tup_end = curr_tup_start;
-        int i = 0;
-        
-        p_semver->num_pr_identifiers = get_num_identifiers(curr_tup_start, end - curr_tup_start);
-        p_semver->pr_identifiers = (char**)malloc(p_semver->num_pr_identifiers*sizeof(char*));
-        
-        while(tup_end <= end)
-        {
-            if('.' == *tup_end || tup_end == end)
-            {
-                p_semver->pr_identifiers[i] = strndup(curr_tup_start, tup_end - curr_tup_start);
-                if(NULL == p_semver->pr_identifiers[i])
-                    return 1;
-                curr_tup_start = tup_end+1;
-                i++;
-            }
-            tup_end++;
-        }
-        
+        return 1;
     }
     
-    if(has_bmd)
+    if(0 != STR_VALIDATOR(semver_str, semver_str_len, NULL, NULL, NULL))
     {
-        char* bmd_str = strrchr(semver_str, '+')+1;
-        p_semver->bmd_str_len = strnlen(bmd_str, MAX_ID_STR_LEN);
-        p_semver->bmd_str = strndup(bmd_str, p_semver->bmd_str_len);
-        if(NULL == p_semver->bmd_str)
-            return 1;
+        return 1;
     }
     
-    return 0;
+    return locate_parts(semver_str, semver_str_len, po_parts);
 }
 
 int semver_compare(const semver_t *p_sva,
@@ -484,10 +805,11 @@ int semver_compare(const semver_t *p_sva,
         return 1;
     }
 
-    //Peform comparisons for each required component.
-    major_cmp = p_sva->major - p_svb->major;
-    minor_cmp = p_sva->minor - p_svb->minor;
-    patch_cmp = p_sva->patch - p_svb->patch;
+    //Peform comparisons for each required component. The components are
+    //unsigned, so subtracting them could wrap; compare instead.
+    major_cmp = CMP(p_sva->major, p_svb->major);
+    minor_cmp = CMP(p_sva->minor, p_svb->minor);
+    patch_cmp = CMP(p_sva->patch, p_svb->patch);
 
     //Compute the overall comparison result.
     //Recall: we are just looking for sign.
@@ -507,10 +829,11 @@ int semver_compare(const semver_t *p_sva,
     //We know the major components are the same,
     //Or else we would have dropped out by now
     //Let's compare the pre-release components
-    if(p_sva->num_pr_identifiers || p_svb->num_pr_identifiers)
+    if(p_sva->pr_len || p_svb->pr_len)
     {
         //If one of these two have a pre-release component.
-        return pre_release_cmp(p_sva, p_svb);
+        *po_result = pre_release_cmp(p_sva, p_svb);
+        return 0;
     }
     else
     {
@@ -544,166 +867,1000 @@ int semver_is_valid(const semver_t *p_semver)
     return 1;
 }
 
-int semver_str_is_valid(const char* semver_str, uint8_t len)
+int semver_str_is_valid(const char* semver_str, size_t len)
 {
+    semver_parts_t parts;
+
     if(NULL == semver_str)
     {
         return 1;
     }
     
-    return semver_str_validator(semver_str, len, NULL, NULL, NULL);
-
-    return 1;
+    return semver_parse_parts(semver_str, len, &parts);
 }
 
-/******************************************************************************
- * static function definitions
- ******************************************************************************/
- //Returns -2 on error.
- static int pre_release_cmp(const semver_t * p_sva, const semver_t *p_svb)
- {
-    int a_num;
-    int b_num;
-    int curr_identifier;
-    if(NULL == p_sva || NULL == p_svb)
+int semver_validate_many(const char* const* strs,
+                         const size_t* lens,
+                         size_t n,
+                         uint8_t *po_status)
+{
+    size_t i;
+    
+    if((0 != n) && (NULL == strs || NULL == lens || NULL == po_status))
     {
-        return -2;
+        return -1;
     }
-
-    a_num = p_sva->num_pr_identifiers;
-    b_num = p_svb->num_pr_identifiers;
-    curr_identifier = 0;
-
-    //Any pre-release component has precedence over having none.
-    int result =
-        (0 == a_num && 0 == b_num)?  0:
-        (0 != a_num && 0 == b_num)? -1:
-        (0 == a_num && 0 != b_num)?  1: 2;
-
-    if(result != 2)
+    
+    for(i=0;i<n;i+=SEMVER_VALIDATE_LANES)
     {
-        return result;
+        validate_lanes(strs + i, lens + i, MIN(n - i, SEMVER_VALIDATE_LANES), po_status + i);
     }
-
-    //From the Spec:
-    //"Precedence for two pre-release is determined by comparing each dot
-    //separated identifier from left to right until a difference is found
-    //as follows:"
     
-    while(curr_identifier != MIN(a_num,b_num))
-    {
-        char *id_a = p_sva->pr_identifiers[curr_identifier];
-        char *id_b = p_svb->pr_identifiers[curr_identifier];
-
-        // "Identifiers consisting of only digits are compared numerically
-        //   and identifiers with letters or hyphens are compared lexically
-        //   in ASCII sort order."
-        //
-        //  "Numeric identifiers always have lower precedence than non-numeric
-        //   identifiers.""
+    return 0;
+}
 
-        result = 
-            ( !is_numeric(id_a) &&  is_numeric(id_b) )?  1:
-            (  is_numeric(id_a) && !is_numeric(id_b) )? -1:
-        ( !is_numeric(id_a) && !is_numeric(id_b) )? cmp_lexical(id_a, id_b): cmp_numeric(id_a, id_b);
+int semver_bump_major(semver_t *p_semver)
+{
+    if(NULL == p_semver)
+    {
+        return 1;
+    }
 
+    if(0 == p_semver->pr_len ||
+       0 != p_semver->minor ||
+       0 != p_semver->patch)
+    {
+        if(UINT32_MAX == p_semver->major)
+        {
+            return 1;
+        }
+        p_semver->major++;
+        p_semver->minor = 0;
+        p_semver->patch = 0;
+    }
+
+    return semver_finalize(p_semver);
+}
+
+int semver_bump_minor(semver_t *p_semver)
+{
+    if(NULL == p_semver)
+    {
+        return 1;
+    }
+
+    if(0 == p_semver->pr_len || 0 != p_semver->patch)
+    {
+        if(UINT32_MAX == p_semver->minor)
+        {
+            return 1;
+        }
+        p_semver->minor++;
+        p_semver->patch = 0;
+    }
+
+    return semver_finalize(p_semver);
+}
+
+int semver_bump_patch(semver_t *p_semver)
+{
+    if(NULL == p_semver)
+    {
+        return 1;
+    }
+
+    if(0 == p_semver->pr_len)
+    {
+        if(UINT32_MAX == p_semver->patch)
+        {
+            return 1;
+        }
+        p_semver->patch++;
+    }
+
+    return semver_finalize(p_semver);
+}
+
+int semver_bump_prerelease(semver_t *p_semver)
+{
+    char* tail;
+    char* id;
+    size_t id_len;
+    size_t i;
+    bool numeric;
+
+    if(NULL == p_semver || 0 == p_semver->pr_len)
+    {
+        return 1;
+    }
+
+    //Only the last identifier matters; find it without splitting the rest.
+    id = SEMVER_TAIL(p_semver) + p_semver->pr_len;
+    while(id > SEMVER_TAIL(p_semver) && '.' != id[-1])
+    {
+        id--;
+    }
+    id_len = SEMVER_TAIL(p_semver) + p_semver->pr_len - id;
+    numeric = is_numeric(id, id_len);
+
+    //Make room up front (an all-nines number gains a digit, anything else
+    //gains ".0") so that a failure leaves the semver untouched. Dropping the
+    //build meta-data usually frees enough space already.
+    if(p_semver->pr_len + 2 > UINT16_MAX ||
+       0 != reserve_tail(p_semver, p_semver->pr_len + 3))
+    {
+        return 1;
+    }
+    tail = SEMVER_TAIL(p_semver);
+    id = tail + p_semver->pr_len - id_len;
+
+    //Also drops the cached string, which the identifier may grow into.
+    clear_bmd(p_semver);
+
+    if(numeric)
+    {
+        //Decimal increment, right to left.
+        i = id_len;
+        while(i > 0 && '9' == id[i-1])
+        {
+            id[--i] = '0';
+        }
+
+        if(i > 0)
+        {
+            id[i-1]++;
+        }
+        else
+        {
+            id[0] = '1';
+            tail[p_semver->pr_len++] = '0';
+        }
+    }
+    else
+    {
+        //Not numeric, start counting: alpha -> alpha.0
+        tail[p_semver->pr_len++] = '.';
+        tail[p_semver->pr_len++] = '0';
+    }
+    tail[p_semver->pr_len] = '\0';
+
+    return 0;
+}
+
+int semver_finalize(semver_t *p_semver)
+{
+    if(NULL == p_semver)
+    {
+        return 1;
+    }
+
+    clear_pr(p_semver);
+    clear_bmd(p_semver);
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+ //Returns -1, 0 or 1; see semver_compare.
+ static int pre_release_cmp(const semver_t * p_sva, const semver_t *p_svb)
+ {
+    //From the Spec:
+    //"Precedence for two pre-release is determined by comparing each dot
+    //separated identifier from left to right until a difference is found"
+    //
+    //The identifiers are walked straight off the stored text, so a
+    //comparison never needs to split (or allocate) anything.
+    return semver_pr_str_cmp(SEMVER_TAIL(p_sva), p_sva->pr_len,
+                             SEMVER_TAIL(p_svb), p_svb->pr_len);
+}
+
+int semver_str_validator_table(const char* semver_str,
+                               size_t semver_str_len,
+                               bool *po_has_primary,
+                               bool *po_has_pre_release,
+                               bool *po_has_bmd)
+{
+    uint32_t seen = 0;
+    uint32_t row = V_START << 3;
+    size_t i;
+
+    if(NULL == semver_str)
+    {
+        return -1;
+    }
+
+    //Two loads per byte and no data-dependent branches; which parts were
+    //present falls out of the states that were visited.
+    for(i=0;i<semver_str_len;i++)
+    {
+        row = g_transitions[row + g_byte_class[(uint8_t)semver_str[i]]];
+        seen |= 1u << (row >> 3);
+    }
+    row = g_transitions[row + C_END];
+
+    if((V_ACCEPT << 3) != row)
+    {
+        return 1;
+    }
+
+    if(NULL != po_has_primary)
+        *po_has_primary = true;
+    if(NULL != po_has_pre_release)
+        *po_has_pre_release = 0 != (seen & (1u << V_PR_ID_START));
+    if(NULL != po_has_bmd)
+        *po_has_bmd = 0 != (seen & (1u << V_BMD_ID_START));
+
+    return 0;
+}
+
+uint32_t semver_dfa_feed(uint32_t state, const char* str, size_t len)
+{
+    size_t i;
+    
+    for(i=0;i<len;i++)
+    {
+        state = g_byte_transitions[state][(uint8_t)str[i]];
+    }
+    
+    return state;
+}
+
+bool semver_dfa_accepts(uint32_t state)
+{
+    return V_ACCEPT == g_byte_transitions[state][0];
+}
+
+size_t semver_longest_prefix(const char* str, size_t len)
+{
+    uint32_t state = V_START;
+    size_t longest = 0;
+    size_t i;
+    
+    if(NULL == str)
+    {
+        return 0;
+    }
+    
+    //A prefix is accepted wherever the end of the string would be.
+    for(i=0;i<len;i++)
+    {
+        state = g_byte_transitions[state][(uint8_t)str[i]];
+        if(V_ERR == state || V_ACCEPT == state)
+        {
+            break;
+        }
+        if(V_ACCEPT == g_byte_transitions[state][0])
+        {
+            longest = i + 1;
+        }
+    }
+    
+    return longest;
+}
+
+int semver_str_validator_re2c(const char* semver_str,
+                              size_t semver_str_len,
+                              bool *po_has_primary,
+                              bool *po_has_pre_release,
+                              bool *po_has_bmd)
+{
+    return semver_str_validator(semver_str, semver_str_len,
+                                po_has_primary, po_has_pre_release, po_has_bmd);
+}
+
+int semver_parse_uint(const char* str,
+                      size_t len,
+                      uint64_t max,
+                      uint64_t *po_value)
+{
+    uint64_t value = 0;
+    uint32_t digit;
+    size_t i = 0;
+
+    if(NULL == str || NULL == po_value)
+    {
+        return -1;
+    }
+
+    //No leading zeros, and UINT64_MAX has 20 digits.
+    if(0 == len || len > 20 || ('0' == str[0] && 1 != len))
+    {
+        return 1;
+    }
+
+    //Eight digits at a time; two chunks are at most 16 digits, which
+    //cannot overflow.
+    for(;i+8<=len;i+=8)
+    {
+        uint64_t chunk = load8(str + i);
+
+        if(!all_digits8(chunk))
+        {
+            return 1;
+        }
+        value = value*100000000u + digits8_value(chunk);
+    }
+
+    for(;i<len;i++)
+    {
+        digit = (uint8_t)str[i] - '0';
+        if(digit > 9 || value > (UINT64_MAX - digit) / 10)
+        {
+            return 1;
+        }
+        value = value*10 + digit;
+    }
+
+    if(value > max)
+    {
+        return 1;
+    }
+
+    *po_value = value;
+    return 0;
+}
+
+int semver_identifier_cmp(const char* id_a, size_t len_a,
+                          const char* id_b, size_t len_b)
+{
+    bool a_is_numeric = is_numeric(id_a, len_a);
+    bool b_is_numeric = is_numeric(id_b, len_b);
+
+    // "Identifiers consisting of only digits are compared numerically
+    //   and identifiers with letters or hyphens are compared lexically
+    //   in ASCII sort order."
+    //
+    //  "Numeric identifiers always have lower precedence than non-numeric
+    //   identifiers.""
+    return ( !a_is_numeric &&  b_is_numeric )?  1:
+           (  a_is_numeric && !b_is_numeric )? -1:
+           ( !a_is_numeric && !b_is_numeric )? cmp_lexical(id_a, len_a, id_b, len_b):
+                                               cmp_numeric(id_a, len_a, id_b, len_b);
+}
+
+int semver_pr_str_cmp(const char* pr_a, size_t len_a,
+                      const char* pr_b, size_t len_b)
+{
+    size_t id_len_a;
+    size_t id_len_b;
+    int result;
+
+    //An empty string stands for "no pre-release", which outranks any.
+    if(0 == len_a || 0 == len_b)
+    {
+        return CMP(0 == len_a, 0 == len_b);
+    }
+
+    for(;;)
+    {
+        id_len_a = next_identifier_len(pr_a, len_a);
+        id_len_b = next_identifier_len(pr_b, len_b);
+
+        result = semver_identifier_cmp(pr_a, id_len_a, pr_b, id_len_b);
         if(0 != result)
         {
             return result;
         }
+
+        //Step past the identifier and its dot, if any.
+        len_a -= (id_len_a < len_a)? id_len_a + 1 : id_len_a;
+        len_b -= (id_len_b < len_b)? id_len_b + 1 : id_len_b;
+        pr_a += id_len_a + 1;
+        pr_b += id_len_b + 1;
+
+        if(0 == len_a || 0 == len_b)
+        {
+            //The longer set of identifiers wins.
+            return CMP(0 != len_a, 0 != len_b);
+        }
     }
+}
 
-    //If we have not returned yet, it's everything has been
-    //equal up to this point... However, before we can say
-    //that these the two pre-release components are equal,
-    //we have to check whether one semver has more release components
-    //than another.
-    //
-    // The spec says: 
-    //     A larger set of pre-release fields has a higher precedence
-    //     than a smaller set, if all of the preceding identifiers
-    //      are equal.
-    if(a_num != b_num)
+int semver_pr_cmp_str(const semver_t *p_semver,
+                      const char* pr_str, size_t pr_len)
+{
+    return semver_pr_str_cmp(SEMVER_TAIL(p_semver), p_semver->pr_len, pr_str, pr_len);
+}
+
+static bool is_numeric(const char* str, size_t len)
+{
+    return 0 != len && is_digits(str, len);
+}
+
+static int cmp_numeric(const char* stra, size_t len_a,
+                       const char* strb, size_t len_b)
+{
+    int result;
+
+    //Arbitrarily long, so compare as digit strings: ignoring leading
+    //zeros, the longer number is the larger one.
+    while(len_a > 1 && '0' == *stra)
+    {
+        stra++;
+        len_a--;
+    }
+    while(len_b > 1 && '0' == *strb)
     {
+        strb++;
+        len_b--;
+    }
 
+    if(len_a != len_b)
+    {
+        return CMP(len_a, len_b);
     }
 
+    result = memcmp(stra, strb, len_a);
+    return CMP(result, 0);
+}
+
+static int cmp_lexical(const char* stra, size_t len_a,
+                       const char* strb, size_t len_b)
+{
+    int result = memcmp(stra, strb, MIN(len_a, len_b));
+
+    return (0 != result)? CMP(result, 0) : CMP(len_a, len_b);
+}
+
+static size_t next_identifier_len(const char* str, size_t str_len)
+{
+    const char* dot = (const char*)memchr(str, '.', str_len);
+
+    return (NULL == dot)? str_len : (size_t)(dot - str);
+}
+
+static bool is_digits(const char* str, size_t str_len)
+{
+    size_t i = 0;
+
+    for(;i+8<=str_len;i+=8)
+    {
+        if(!all_digits8(load8(str + i)))
+        {
+            return false;
+        }
+    }
+
+    for(;i<str_len;i++)
+    {
+        if(str[i] < '0' || str[i] > '9')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//Loads 8 characters so that str[0] is the low byte, whatever the host's
+//byte order. Compilers turn this into a single load on little endian.
+static uint64_t load8(const char* str)
+{
+    uint64_t chunk = 0;
+    int i;
+
+    for(i=0;i<8;i++)
+    {
+        chunk |= (uint64_t)(uint8_t)str[i] << (8*i);
+    }
+
+    return chunk;
+}
+
+static bool all_digits8(uint64_t chunk)
+{
+    //Every byte must be 0x30..0x39: the high nibble is 3 and adding 6
+    //does not carry out of the low nibble.
+    return 0 == ((chunk & 0xF0F0F0F0F0F0F0F0ull) ^ 0x3030303030303030ull) &&
+           0 == (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) ^
+                 0x3030303030303030ull);
+}
+
+//Value of 8 ASCII digits, most significant in the low byte. Pairs, then
+//quads, then the whole word are combined with one multiply each.
+static uint32_t digits8_value(uint64_t chunk)
+{
+    chunk = (chunk & 0x0F0F0F0F0F0F0F0Full) * (1 + (10ull << 8)) >> 8;
+    chunk = (chunk & 0x00FF00FF00FF00FFull) * (1 + (100ull << 16)) >> 16;
+    return (uint32_t)((chunk & 0x0000FFFF0000FFFFull) * (1 + (10000ull << 32)) >> 32);
+}
+
+//Parses "MAJOR.MINOR.PATCH" spanning [core, core_end).
+static int parse_core(const char* core, const char* core_end, semver_parts_t *po_parts)
+{
+    uint32_t *components[3];
+    const char* dot;
+    uint64_t value;
+    int i;
+
+    components[0] = &po_parts->major;
+    components[1] = &po_parts->minor;
+    components[2] = &po_parts->patch;
+
+    for(i=0;i<3;i++)
+    {
+        dot = (const char*)memchr(core, '.', core_end - core);
+        if(NULL == dot)
+        {
+            dot = core_end;
+        }
+
+        if(0 != semver_parse_uint(core, dot - core, UINT32_MAX, &value))
+        {
+            return 1;
+        }
+        *components[i] = (uint32_t)value;
+        core = dot + 1;
+    }
+
+    return 0;
+}
+
+//"Numeric identifiers MUST NOT include leading zeroes."
+static bool pr_ids_canonical(const char* pr_str, size_t pr_len)
+{
+    size_t id_len;
+
+    while(0 != pr_len)
+    {
+        id_len = next_identifier_len(pr_str, pr_len);
+        if(id_len > 1 && '0' == pr_str[0] && is_digits(pr_str, id_len))
+        {
+            return false;
+        }
+
+        pr_len -= (id_len < pr_len)? id_len + 1 : id_len;
+        pr_str += id_len + 1;
+    }
+
+    return true;
+}
+
+//Splits a string the validator accepted into its parts. The validator
+//accepts any run of digits, so ranges and leading zeros are checked here.
+static int locate_parts(const char* semver_str,
+                        size_t semver_str_len,
+                        semver_parts_t *po_parts)
+{
+    const char* bmd_start = NULL;
+    const char* pr_start = NULL;
+    const char* pr_end = NULL;
+    
+    memset(po_parts, 0, sizeof(semver_parts_t));
+    
+    //The core triple holds neither '-' nor '+', and build meta-data always
+    //starts at the first '+', so the first '-' before it opens the
+    //pre-release. The validator guarantees both are well formed.
+    bmd_start = (const char*)memchr(semver_str, '+', semver_str_len);
+    pr_end = (NULL != bmd_start)? bmd_start : semver_str + semver_str_len;
+    pr_start = (const char*)memchr(semver_str, '-', pr_end - semver_str);
+    
+    if(NULL != pr_start)
+    {
+        pr_start++;
+        po_parts->pr_off = pr_start - semver_str;
+        po_parts->pr_len = pr_end - pr_start;
+    }
+    
+    if(0 != parse_core(semver_str,
+                       (NULL != pr_start)? pr_start - 1 : pr_end,
+                       po_parts))
+    {
+        return 1;
+    }
+    
+    if(NULL != pr_start && !pr_ids_canonical(pr_start, po_parts->pr_len))
+    {
+        return 1;
+    }
+    
+    if(NULL != bmd_start)
+    {
+        po_parts->bmd_off = bmd_start + 1 - semver_str;
+        po_parts->bmd_len = semver_str_len - po_parts->bmd_off;
+    }
+    
     return 0;
- }
-
-//  static int pre_release_str_cmp(const char* pr_stra, const char* pr_strb)
-//  {
-//     int bytes_to_compare = 0;
-//     int i = 0;
-//     int result =
-//     (NULL == pr_stra && NULL == pr_strb)?  0:
-//     (NULL != pr_stra && NULL == pr_strb)? -1:
-//     (NULL == pr_stra && NULL != pr_strb)?  1: 2;
-
-//     if(result != 2)
-//     {
-//         return result;
-//     }
-
-//     //Result of 2 indicates that both stra and strb are not NULL
-//     bytes_to_compare = MAX(strlen(pr_stra),strlen(pr_strb));
-
-//     for(i =0; i<bytes_to_compare;i++)
-//     {
-//         result = strcmp(pr_stra[i], pr_strb[i]);
-//         if(result)
-//         {
-//             return result;
-//         }
-//     }
-
-//     return 0;
-// }
-
-static bool is_numeric(const char* str)
-{
-    int result = (int)strtol(str, NULL, 10);
- 
-    if (result == 0 && str[0] != '0')
-       return false;
+}
+
+//Walks up to SEMVER_VALIDATE_LANES strings through the DFA in lockstep.
+//Each walk is a chain of dependent loads; stepping several at once lets
+//their latencies overlap. Missing lanes are padded with empty strings
+//that start out in the error state, so every group is a full one.
+static void validate_lanes(const char* const* strs,
+                           const size_t* lens,
+                           size_t num_lanes,
+                           uint8_t *po_status)
+{
+    const char* lane_strs[SEMVER_VALIDATE_LANES];
+    size_t lane_lens[SEMVER_VALIDATE_LANES];
+    uint32_t states[SEMVER_VALIDATE_LANES];
+    size_t min_len = SIZE_MAX;
+    size_t i;
+    size_t k;
+    
+    for(k=0;k<SEMVER_VALIDATE_LANES;k++)
+    {
+        bool live = k < num_lanes && NULL != strs[k];
+        
+        lane_strs[k] = live? strs[k] : "";
+        lane_lens[k] = live? lens[k] : 0;
+        states[k] = live? V_START : V_ERR;
+        min_len = MIN(min_len, lane_lens[k]);
+    }
+    
+    //Up to the shortest length every lane has a byte. The lanes only stay
+    //in registers if the inner loop is unrolled.
+    for(i=0;i<min_len;i++)
+    {
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 8
+#endif
+        for(k=0;k<SEMVER_VALIDATE_LANES;k++)
+        {
+            states[k] = g_byte_transitions[states[k]][(uint8_t)lane_strs[k][i]];
+        }
+    }
+    
+    for(k=0;k<num_lanes;k++)
+    {
+        semver_parts_t parts;
+        uint32_t state = states[k];
+        size_t len;
+        
+        //Finish the longer strings one at a time.
+        for(i=min_len;i<lane_lens[k];i++)
+        {
+            state = g_byte_transitions[state][(uint8_t)lane_strs[k][i]];
+        }
+        state = g_byte_transitions[state][0];
+        
+        //Only strings that pass the grammar pay for the range and leading
+        //zero checks.
+        po_status[k] = 1;
+        if(V_ACCEPT != state)
+        {
+            continue;
+        }
+        
+        len = strnlen(lane_strs[k], lane_lens[k]);
+        if(len <= UINT16_MAX && 0 == locate_parts(lane_strs[k], len, &parts))
+        {
+            po_status[k] = 0;
+        }
+    }
+}
+
+//Writes the canonical string, terminated, into str; it must have room for
+//MAX_CORE_STR_LEN + pr_len + bmd_len + 3 bytes. Returns its length.
+static size_t format_str(const semver_t *p_semver, char* str)
+{
+    size_t len;
+    
+    len = snprintf(str, MAX_CORE_STR_LEN + 1, "%u.%u.%u",
+                   p_semver->major, p_semver->minor, p_semver->patch);
+    
+    if(0 != p_semver->pr_len)
+    {
+        str[len++] = '-';
+        memcpy(str + len, SEMVER_TAIL(p_semver), p_semver->pr_len);
+        len += p_semver->pr_len;
+    }
+    
+    if(0 != p_semver->bmd_len)
+    {
+        str[len++] = '+';
+        memcpy(str + len, BMD_STR(p_semver), p_semver->bmd_len);
+        len += p_semver->bmd_len;
+    }
+    
+    str[len] = '\0';
+    return len;
+}
+
+//The length format_str will write, without the terminator.
+static size_t formatted_len(const semver_t *p_semver)
+{
+    size_t len;
+
+    len = decimal_len(p_semver->major) + 1 +
+          decimal_len(p_semver->minor) + 1 +
+          decimal_len(p_semver->patch);
+
+    if(0 != p_semver->pr_len)
+    {
+        len += 1 + p_semver->pr_len;
+    }
+
+    if(0 != p_semver->bmd_len)
+    {
+        len += 1 + p_semver->bmd_len;
+    }
+
+    return len;
+}
+
+static size_t decimal_len(uint32_t value)
+{
+    size_t len = 1;
+
+    while(value >= 10)
+    {
+        value /= 10;
+        len++;
+    }
+
+    return len;
+}
+
+static void clear_pr(semver_t *p_semver)
+{
+    //Only ever shrinks the tail, so this cannot fail.
+    store_pr(p_semver, NULL, 0);
+}
+
+static void clear_bmd(semver_t *p_semver)
+{
+    p_semver->bmd_len = 0;
+    p_semver->str_len = 0;
+}
+
+//Grows the tail buffer to hold at least needed bytes, keeping its contents.
+static int reserve_tail(semver_t *p_semver, uint32_t needed)
+{
+    char* tail;
+
+    if(needed <= tail_capacity(p_semver))
+    {
+        return 0;
+    }
+
+    if(NULL != p_semver->tail && !is_borrowed(p_semver))
+    {
+        tail = (char*)realloc(p_semver->tail, needed);
+        if(NULL == tail)
+        {
+            return 1;
+        }
+
+        p_semver->tail = tail;
+        p_semver->tail_cap = needed;
+        return 0;
+    }
+
+    //Moving out of the inline buffer, or taking a private copy of borrowed
+    //text (which is never written to). Borrowed text may fit inline.
+    needed = MAX(needed, (uint32_t)p_semver->pr_len + p_semver->bmd_len + 2);
+    if(needed <= SEMVER_INLINE_TAIL_LEN)
+    {
+        tail = p_semver->inline_tail;
+    }
+    else
+    {
+        tail = (char*)malloc(needed);
+        if(NULL == tail)
+        {
+            return 1;
+        }
+    }
+
+    memcpy(tail, SEMVER_TAIL(p_semver), p_semver->pr_len);
+    tail[p_semver->pr_len] = '\0';
+    memcpy(tail + p_semver->pr_len + 1, BMD_STR(p_semver), p_semver->bmd_len);
+    tail[p_semver->pr_len + 1 + p_semver->bmd_len] = '\0';
+    //The cached string is left behind.
+    p_semver->str_len = 0;
+
+    if(tail == p_semver->inline_tail)
+    {
+        p_semver->tail = NULL;
+        p_semver->tail_cap = 0;
+    }
     else
-       return true;
+    {
+        p_semver->tail = tail;
+        p_semver->tail_cap = needed;
+    }
+    return 0;
 }
 
-static int cmp_numeric(const char* stra, const char* strb)
+static uint32_t tail_capacity(const semver_t *p_semver)
 {
-    int num_a = (int)strtol(stra, NULL, 10);
-    int num_b = (int)strtol(strb, NULL, 10);
+    return (NULL == p_semver->tail)? SEMVER_INLINE_TAIL_LEN : p_semver->tail_cap;
+}
 
-    return num_a - num_b;
+static bool is_borrowed(const semver_t *p_semver)
+{
+    return NULL != p_semver->tail && 0 == p_semver->tail_cap;
 }
 
-static int cmp_lexical(const char* stra, const char* strb)
+//Parses into an existing semver, reusing its tail buffer. The semver is
+//left alone if the string is invalid, and reset if storing fails.
+static int parse_into(semver_t *p_semver,
+                      const char* semver_str,
+                      uint16_t semver_str_len,
+                      uint32_t flags)
 {
-    return strcmp(stra,strb);
+    semver_parts_t parts;
+
+    //Whatever gets dropped below is still validated here.
+    if(0 != semver_parse_parts(semver_str, semver_str_len, &parts))
+    {
+        return 1;
+    }
+
+    if(flags & SEMVER_VALIDATE_ONLY)
+    {
+        return 0;
+    }
+
+    if(flags & SEMVER_PRIMARY_ONLY)
+    {
+        parts.pr_len = 0;
+        parts.bmd_len = 0;
+    }
+    if(flags & SEMVER_SKIP_BMD)
+    {
+        parts.bmd_len = 0;
+    }
+
+    if(NULL != p_semver && in_tail(p_semver, semver_str))
+    {
+        //Parsing our own text: resetting would clobber the source, so
+        //build the result on the side.
+        semver_t copy = { 0 };
+        int result = parse_into(&copy, semver_str, semver_str_len,
+                                flags & ~SEMVER_NO_COPY);
+
+        if(0 == result)
+        {
+            semver_fini(p_semver);
+            *p_semver = copy;
+        }
+        return result;
+    }
+
+    semver_reset(p_semver);
+    p_semver->major = parts.major;
+    p_semver->minor = parts.minor;
+    p_semver->patch = parts.patch;
+
+    if(0 == parts.pr_len && 0 == parts.bmd_len)
+    {
+        //Nothing to store.
+    }
+    else if(flags & SEMVER_NO_COPY)
+    {
+        //"<pr>+<bmd>" already has the stored layout, with '+' standing in
+        //for the separating NUL. A zero capacity marks the tail as
+        //borrowed; it is copied before anything writes to it.
+        if(!is_borrowed(p_semver))
+        {
+            free(p_semver->tail);
+        }
+        p_semver->tail_cap = 0;
+        p_semver->tail = (char*)semver_str +
+                         ((0 != parts.pr_len)? parts.pr_off : parts.bmd_off - 1);
+        p_semver->pr_len = parts.pr_len;
+        p_semver->bmd_len = parts.bmd_len;
+    }
+    else
+    {
+        //The whole tail is copied in one go, into the existing buffer if
+        //it is big enough; identifiers are left unsplit until somebody
+        //actually looks at them.
+        if(0 != reserve_tail(p_semver, parts.pr_len + parts.bmd_len + 2) ||
+           0 != store_pr(p_semver, semver_str + parts.pr_off, parts.pr_len) ||
+           0 != store_bmd(p_semver, semver_str + parts.bmd_off, parts.bmd_len))
+        {
+            semver_reset(p_semver);
+            return -1;
+        }
+    }
+
+    return 0;
 }
 
-static int get_num_identifiers(const char* str, uint16_t str_len)
+static bool in_tail(const semver_t *p_semver, const char* str)
 {
-    int i;
-    int num_identifiers;
+    return str >= SEMVER_TAIL(p_semver) &&
+           str < SEMVER_TAIL(p_semver) + tail_capacity(p_semver);
+}
+
+//Replaces the pre-release text, sliding the build meta-data (if any) to
+//its new place behind it. An empty pr_str removes the pre-release.
+static int store_pr(semver_t *p_semver, const char* pr_str, uint16_t pr_len)
+{
+    char* tail;
+    char* copy;
+    int result;
+
+    p_semver->str_len = 0;
+
+    //The buffer is about to be rearranged, so don't read from it.
+    if(0 != pr_len && in_tail(p_semver, pr_str))
+    {
+        copy = strndup(pr_str, pr_len);
+        if(NULL == copy)
+        {
+            return 1;
+        }
+        result = store_pr(p_semver, copy, pr_len);
+        free(copy);
+        return result;
+    }
 
-    if(str_len == 0)
+    if(0 == pr_len && 0 == p_semver->bmd_len)
     {
+        //Nothing left to store, but keep the buffer around for reuse.
+        p_semver->pr_len = 0;
         return 0;
     }
 
-    num_identifiers = 1;
+    if(0 != reserve_tail(p_semver,
+                         pr_len + 1 +
+                         (p_semver->bmd_len? p_semver->bmd_len + 1 : 0)))
+    {
+        return 1;
+    }
+
+    tail = SEMVER_TAIL(p_semver);
+    if(0 != p_semver->bmd_len)
+    {
+        memmove(tail + pr_len + 1,
+                BMD_STR(p_semver),
+                p_semver->bmd_len + 1);
+    }
+    if(0 != pr_len)
+    {
+        memcpy(tail, pr_str, pr_len);
+    }
+    tail[pr_len] = '\0';
+    p_semver->pr_len = pr_len;
 
-    for(i=0;i<str_len;i++)
+    return 0;
+}
+
+//Replaces the build meta-data text. An empty bmd_str removes it.
+static int store_bmd(semver_t *p_semver, const char* bmd_str, uint16_t bmd_len)
+{
+    char* tail;
+    char* copy;
+    int result;
+
+    p_semver->str_len = 0;
+
+    if(0 != bmd_len && in_tail(p_semver, bmd_str))
     {
-        if(str[i] == '.')
+        copy = strndup(bmd_str, bmd_len);
+        if(NULL == copy)
         {
-            num_identifiers++;
+            return 1;
         }
+        result = store_bmd(p_semver, copy, bmd_len);
+        free(copy);
+        return result;
     }
-    
-    return num_identifiers;
+
+    if(0 == bmd_len)
+    {
+        clear_bmd(p_semver);
+        return 0;
+    }
+
+    if(0 != reserve_tail(p_semver, p_semver->pr_len + bmd_len + 2))
+    {
+        return 1;
+    }
+
+    tail = SEMVER_TAIL(p_semver);
+    tail[p_semver->pr_len] = '\0';
+    memcpy(tail + p_semver->pr_len + 1, bmd_str, bmd_len);
+    tail[p_semver->pr_len + 1 + bmd_len] = '\0';
+    p_semver->bmd_len = bmd_len;
+
+    return 0;
 }
 
 /******************************************************************************
@@ -714,7 +1871,7 @@ static int get_num_identifiers(const char* str, uint16_t str_len)
  * file.
  ******************************************************************************/
 static int semver_str_validator(const char *semver_str,
-                                uint16_t semver_str_len,
+                                size_t semver_str_len,
                                 bool *po_has_primary,
                                 bool *po_has_pre_release,
                                 bool *po_has_bmd)
@@ -735,7 +1892,12 @@ static int semver_str_validator(const char *semver_str,
 #define YYCURSOR    p
 #define YYLIMIT     (semver_str+semver_str_len)
 #define YYMARKER    q
-#define YYFILL(n)
+/* Bounds checked input: the end of the input reads as the terminating NUL
+ * the rules expect, so nothing past semver_str_len is ever read. */
+#define YYPEEK()    ((YYCURSOR < YYLIMIT)? *YYCURSOR : '\0')
+#define YYSKIP()    (YYCURSOR += (YYCURSOR < YYLIMIT))
+#define YYBACKUP()  (YYMARKER = YYCURSOR)
+#define YYRESTORE() (YYCURSOR = YYMARKER)
     
     for(;;)
     {
@@ -743,8 +1905,7 @@ static int semver_str_validator(const char *semver_str,
         {
             YYCTYPE yych;
             
-            if ((YYLIMIT - YYCURSOR) < 3) YYFILL(3);
-            yych = *YYCURSOR;
+            yych = YYPEEK();
             switch (yych) {
                 case '0':
                 case '1':
@@ -759,7 +1920,9 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy4;
             }
         yy2:
-            yych = *(YYMARKER = ++YYCURSOR);
+            YYSKIP();
+            YYBACKUP();
+            yych = YYPEEK();
             switch (yych) {
                 case '.':	goto yy5;
                 case '0':
@@ -780,10 +1943,12 @@ static int semver_str_validator(const char *semver_str,
                 break;
             }
         yy4:
-            yych = *++YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             goto yy3;
         yy5:
-            yych = *++YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case '0':
                 case '1':
@@ -798,12 +1963,11 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy6:
-            YYCURSOR = YYMARKER;
+            YYRESTORE();
             goto yy3;
         yy7:
-            ++YYCURSOR;
-            if ((YYLIMIT - YYCURSOR) < 2) YYFILL(2);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case '.':	goto yy5;
                 case '0':
@@ -819,9 +1983,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy9:
-            ++YYCURSOR;
-            if ((YYLIMIT - YYCURSOR) < 2) YYFILL(2);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case '.':	goto yy11;
                 case '0':
@@ -837,7 +2000,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy11:
-            yych = *++YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case '0':
                 case '1':
@@ -852,9 +2016,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy12:
-            ++YYCURSOR;
-            if ((YYLIMIT - YYCURSOR) < 2) YYFILL(2);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case 0x00:	goto yy16;
                 case '+':	goto yy15;
@@ -872,7 +2035,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy14:
-            yych = *++YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case 0x00:
                 case '+':
@@ -880,22 +2044,22 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy26;
             }
         yy15:
-            yych = *++YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case 0x00:
                 case '.':	goto yy6;
                 default:	goto yy19;
             }
         yy16:
-            ++YYCURSOR;
+            YYSKIP();
             {
                 has_primary = true;
                 break;
             }
         yy18:
-            ++YYCURSOR;
-            if (YYLIMIT <= YYCURSOR) YYFILL(1);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
         yy19:
             switch (yych) {
                 case 0x00:	goto yy21;
@@ -966,9 +2130,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy20:
-            ++YYCURSOR;
-            if (YYLIMIT <= YYCURSOR) YYFILL(1);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case '-':
                 case '0':
@@ -1036,16 +2199,15 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy21:
-            ++YYCURSOR;
+            YYSKIP();
             {
                 has_primary = true;
                 has_bmd = true;
                 break;
             }
         yy23:
-            ++YYCURSOR;
-            if (YYLIMIT <= YYCURSOR) YYFILL(1);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case 0x00:	goto yy21;
                 case '-':
@@ -1115,9 +2277,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy25:
-            ++YYCURSOR;
-            if ((YYLIMIT - YYCURSOR) < 2) YYFILL(2);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
         yy26:
             switch (yych) {
                 case 0x00:	goto yy29;
@@ -1189,9 +2350,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy27:
-            ++YYCURSOR;
-            if (YYLIMIT <= YYCURSOR) YYFILL(1);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case '-':
                 case '0':
@@ -1259,23 +2419,23 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy28:
-            yych = *++YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case 0x00:
                 case '.':	goto yy6;
                 default:	goto yy32;
             }
         yy29:
-            ++YYCURSOR;
+            YYSKIP();
             {
                 has_primary = true;
                 has_pre_release = true;
                 break;
             }
         yy31:
-            ++YYCURSOR;
-            if (YYLIMIT <= YYCURSOR) YYFILL(1);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
         yy32:
             switch (yych) {
                 case 0x00:	goto yy34;
@@ -1346,9 +2506,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy33:
-            ++YYCURSOR;
-            if (YYLIMIT <= YYCURSOR) YYFILL(1);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case '-':
                 case '0':
@@ -1416,7 +2575,7 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy34:
-            ++YYCURSOR;
+            YYSKIP();
             {
                 has_primary = true;
                 has_pre_release = true;
@@ -1424,9 +2583,8 @@ static int semver_str_validator(const char *semver_str,
                 break;
             }
         yy36:
-            ++YYCURSOR;
-            if (YYLIMIT <= YYCURSOR) YYFILL(1);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case 0x00:	goto yy34;
                 case '-':
@@ -1496,9 +2654,8 @@ static int semver_str_validator(const char *semver_str,
                 default:	goto yy6;
             }
         yy38:
-            ++YYCURSOR;
-            if ((YYLIMIT - YYCURSOR) < 2) YYFILL(2);
-            yych = *YYCURSOR;
+            YYSKIP();
+            yych = YYPEEK();
             switch (yych) {
                 case 0x00:	goto yy29;
                 case '+':	goto yy28;
@@ -1593,7 +2750,7 @@ static int semver_str_validator(const char *semver_str,
  ******************************************************************************/
 #if 0
 static int semver_str_validator(const char *semver_str,
-                                uint16_t semver_str_len,
+                                size_t semver_str_len,
                                 bool *po_has_primary,
                                 bool *po_has_pre_release,
                                 bool *po_has_bmd)
@@ -1614,12 +2771,19 @@ static int semver_str_validator(const char *semver_str,
 #define YYCURSOR    p
 #define YYLIMIT     (semver_str+semver_str_len)
 #define YYMARKER    q
-#define YYFILL(n)
+/* Bounds checked input: the end of the input reads as the terminating NUL
+ * the rules expect, so nothing past semver_str_len is ever read. */
+#define YYPEEK()    ((YYCURSOR < YYLIMIT)? *YYCURSOR : '\0')
+#define YYSKIP()    (YYCURSOR += (YYCURSOR < YYLIMIT))
+#define YYBACKUP()  (YYMARKER = YYCURSOR)
+#define YYRESTORE() (YYCURSOR = YYMARKER)
     
     for(;;)
     {
         /*!re2c
          re2c:indent:top = 2;
+         re2c:flags:input = custom;
+         re2c:yyfill:enable = 0;
          PRIMARY         = [0-9]+'.'[0-9]+'.'[0-9]+ ;
          PRE_RELEASE     = '-'([0-9A-Za-z-]+(('.'[0-9A-Za-z-]+)+)*) ;
          BUILD_META_DATA = '+'([0-9A-Za-z-]+(('.'[0-9A-Za-z-]+)+)*) ;
@@ -0,0 +1,352 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "semver.h"
+#include "semver_batch.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Upper bound on workers, regardless of what the caller asks for. */
+#define MAX_WORKERS 256
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef struct batch_worker_
+{
+    const char* buf;
+    size_t chunk_start;
+    size_t chunk_end;
+
+    //Filled in by the counting pass...
+    size_t num_records;
+    //...and used by the parsing pass.
+    size_t first_record;
+    semver_batch_t *p_batch;
+} batch_worker_t;
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void* count_records(void *p_arg);
+static void* parse_records(void *p_arg);
+static void parse_line(semver_batch_t *p_batch,
+                       size_t record,
+                       const char* buf,
+                       size_t line_start,
+                       size_t line_end);
+static semver_batch_t* batch_alloc(size_t count);
+static int run_workers(batch_worker_t *workers,
+                       uint32_t num_workers,
+                       void* (*fn)(void*));
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_batch_parse(const char* buf,
+                       size_t len,
+                       semver_batch_t **p2o_batch)
+{
+    return semver_batch_parse_parallel(buf, len, 1, p2o_batch);
+}
+
+int semver_batch_parse_parallel(const char* buf,
+                                size_t len,
+                                uint32_t num_threads,
+                                semver_batch_t **p2o_batch)
+{
+    batch_worker_t *workers = NULL;
+    semver_batch_t *p_batch = NULL;
+    size_t max_workers;
+    size_t prev_end;
+    size_t total;
+    uint32_t num_workers;
+    uint32_t i;
+
+    if(NULL == buf || NULL == p2o_batch)
+    {
+        return 1;
+    }
+
+    if(0 == num_threads)
+    {
+        long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (num_cpus > 0)? (uint32_t)num_cpus : 1;
+    }
+
+    //Don't bother splitting buffers that are small to begin with.
+    max_workers = len / SEMVER_BATCH_MIN_CHUNK_LEN + 1;
+    num_workers = num_threads;
+    if(num_workers > max_workers)
+    {
+        num_workers = max_workers;
+    }
+    if(num_workers > MAX_WORKERS)
+    {
+        num_workers = MAX_WORKERS;
+    }
+
+    workers = (batch_worker_t*)calloc(num_workers, sizeof(batch_worker_t));
+    if(NULL == workers)
+    {
+        return 1;
+    }
+
+    //Cut at roughly equal offsets, then slide each cut forward to just past
+    //the next newline so no record straddles two chunks.
+    prev_end = 0;
+    for(i=0;i<num_workers;i++)
+    {
+        size_t cut = (i == num_workers - 1)? len : (len / num_workers) * (i + 1);
+
+        if(cut < prev_end)
+        {
+            cut = prev_end;
+        }
+        if(cut < len && cut > 0 && '\n' != buf[cut - 1])
+        {
+            const char* nl = (const char*)memchr(buf + cut, '\n', len - cut);
+            cut = (NULL == nl)? len : (size_t)(nl - buf) + 1;
+        }
+
+        workers[i].buf = buf;
+        workers[i].chunk_start = prev_end;
+        workers[i].chunk_end = cut;
+        prev_end = cut;
+    }
+
+    if(0 != run_workers(workers, num_workers, count_records))
+    {
+        free(workers);
+        return 1;
+    }
+
+    total = 0;
+    for(i=0;i<num_workers;i++)
+    {
+        workers[i].first_record = total;
+        total += workers[i].num_records;
+    }
+
+    p_batch = batch_alloc(total);
+    if(NULL == p_batch)
+    {
+        free(workers);
+        return 1;
+    }
+
+    for(i=0;i<num_workers;i++)
+    {
+        workers[i].p_batch = p_batch;
+    }
+
+    if(0 != run_workers(workers, num_workers, parse_records))
+    {
+        free(p_batch);
+        free(workers);
+        return 1;
+    }
+
+    free(workers);
+    *p2o_batch = p_batch;
+    return 0;
+}
+
+int semver_batch_destroy(semver_batch_t *po_batch)
+{
+    if(NULL == po_batch)
+    {
+        return 1;
+    }
+
+    //The columns live in the same allocation as the batch itself.
+    free(po_batch);
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static void* count_records(void *p_arg)
+{
+    batch_worker_t *p_worker = (batch_worker_t*)p_arg;
+    const char* curr = p_worker->buf + p_worker->chunk_start;
+    const char* end = p_worker->buf + p_worker->chunk_end;
+    const char* nl;
+    size_t num_records = 0;
+
+    while(curr < end)
+    {
+        nl = (const char*)memchr(curr, '\n', end - curr);
+        if(NULL == nl)
+        {
+            //Unterminated final line.
+            num_records++;
+            break;
+        }
+        num_records++;
+        curr = nl + 1;
+    }
+
+    p_worker->num_records = num_records;
+    return NULL;
+}
+
+static void* parse_records(void *p_arg)
+{
+    batch_worker_t *p_worker = (batch_worker_t*)p_arg;
+    size_t record = p_worker->first_record;
+    size_t curr = p_worker->chunk_start;
+    size_t end = p_worker->chunk_end;
+    const char* nl;
+
+    while(curr < end)
+    {
+        nl = (const char*)memchr(p_worker->buf + curr, '\n', end - curr);
+        if(NULL == nl)
+        {
+            parse_line(p_worker->p_batch, record, p_worker->buf, curr, end);
+            break;
+        }
+
+        parse_line(p_worker->p_batch, record, p_worker->buf, curr, nl - p_worker->buf);
+        record++;
+        curr = (nl - p_worker->buf) + 1;
+    }
+
+    return NULL;
+}
+
+static void parse_line(semver_batch_t *p_batch,
+                       size_t record,
+                       const char* buf,
+                       size_t line_start,
+                       size_t line_end)
+{
+    semver_parts_t parts;
+    size_t line_len;
+
+    if(line_end > line_start && '\r' == buf[line_end - 1])
+    {
+        line_end--;
+    }
+    line_len = line_end - line_start;
+
+    memset(&parts, 0, sizeof(parts));
+    p_batch->status[record] = 1;
+    p_batch->line_off[record] = line_start;
+    p_batch->line_len[record] = (line_len > UINT16_MAX)? UINT16_MAX : line_len;
+
+    //Lines are validated in place. Embedded NULs would make a line look
+    //shorter than it is, so those are rejected up front.
+    if(0 != line_len && line_len <= SEMVER_BATCH_MAX_LINE_LEN &&
+       NULL == memchr(buf + line_start, '\0', line_len))
+    {
+        if(0 == semver_parse_parts(buf + line_start, line_len, &parts))
+        {
+            p_batch->status[record] = 0;
+        }
+        else
+        {
+            memset(&parts, 0, sizeof(parts));
+        }
+    }
+
+    p_batch->major[record] = parts.major;
+    p_batch->minor[record] = parts.minor;
+    p_batch->patch[record] = parts.patch;
+    p_batch->pr_off[record] = parts.pr_off;
+    p_batch->pr_len[record] = parts.pr_len;
+    p_batch->bmd_off[record] = parts.bmd_off;
+    p_batch->bmd_len[record] = parts.bmd_len;
+}
+
+//One allocation holds the batch header followed by every column, widest
+//element type first so that each column stays naturally aligned.
+static semver_batch_t* batch_alloc(size_t count)
+{
+    semver_batch_t *p_batch;
+    size_t bytes;
+    char* p_col;
+
+    bytes = sizeof(semver_batch_t) +
+            count * (sizeof(size_t) +
+                     3 * sizeof(uint32_t) +
+                     5 * sizeof(uint16_t) +
+                     sizeof(uint8_t));
+
+    p_batch = (semver_batch_t*)malloc(bytes);
+    if(NULL == p_batch)
+    {
+        return NULL;
+    }
+
+    p_batch->count = count;
+    p_col = (char*)(p_batch + 1);
+
+    p_batch->line_off = (size_t*)p_col;   p_col += count * sizeof(size_t);
+    p_batch->major = (uint32_t*)p_col;    p_col += count * sizeof(uint32_t);
+    p_batch->minor = (uint32_t*)p_col;    p_col += count * sizeof(uint32_t);
+    p_batch->patch = (uint32_t*)p_col;    p_col += count * sizeof(uint32_t);
+    p_batch->line_len = (uint16_t*)p_col; p_col += count * sizeof(uint16_t);
+    p_batch->pr_off = (uint16_t*)p_col;   p_col += count * sizeof(uint16_t);
+    p_batch->pr_len = (uint16_t*)p_col;   p_col += count * sizeof(uint16_t);
+    p_batch->bmd_off = (uint16_t*)p_col;  p_col += count * sizeof(uint16_t);
+    p_batch->bmd_len = (uint16_t*)p_col;  p_col += count * sizeof(uint16_t);
+    p_batch->status = (uint8_t*)p_col;
+
+    return p_batch;
+}
+
+//Runs fn over every worker; the calling thread takes the first one itself.
+static int run_workers(batch_worker_t *workers,
+                       uint32_t num_workers,
+                       void* (*fn)(void*))
+{
+    pthread_t threads[MAX_WORKERS];
+    uint32_t num_started = 0;
+    uint32_t i;
+    int result = 0;
+
+    for(i=1;i<num_workers;i++)
+    {
+        if(0 != pthread_create(&threads[i], NULL, fn, &workers[i]))
+        {
+            result = 1;
+            break;
+        }
+        num_started = i;
+    }
+
+    fn(&workers[0]);
+
+    for(i=1;i<=num_started;i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    return result;
+}
@@ -0,0 +1,386 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "semver.h"
+#include "semver_cache.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME        16777619u
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef struct cache_entry_
+{
+    //Frozen; the entry holds one reference and every caller its own, so an
+    //evicted semver lives on until the last caller lets go of it.
+    const semver_t *p_semver;
+
+    struct cache_entry_ *p_next;
+    bool referenced;
+    uint32_t hash;
+    uint16_t key_len;
+    char key[];
+} cache_entry_t;
+
+typedef struct cache_shard_
+{
+    pthread_mutex_t lock;
+
+    cache_entry_t **buckets;
+    uint32_t bucket_mask;
+
+    //CLOCK ring; the hand sweeps it looking for an unreferenced victim.
+    cache_entry_t **ring;
+    uint32_t capacity;
+    uint32_t num_entries;
+    uint32_t hand;
+} cache_shard_t;
+
+struct semver_cache_
+{
+    cache_shard_t shards[SEMVER_CACHE_NUM_SHARDS];
+
+    atomic_uint_fast64_t hits;
+    atomic_uint_fast64_t misses;
+    atomic_uint_fast64_t evictions;
+};
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static uint32_t hash_bytes(const char* str, uint16_t len);
+static cache_entry_t* shard_find(cache_shard_t *p_shard,
+                                 uint32_t hash,
+                                 const char* key,
+                                 uint16_t key_len);
+static void shard_unlink(cache_shard_t *p_shard, cache_entry_t *p_entry);
+static void shard_insert(semver_cache_t *p_cache,
+                         cache_shard_t *p_shard,
+                         cache_entry_t *p_entry);
+static void entry_destroy(cache_entry_t *p_entry);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_cache_create(semver_cache_t **p2o_cache, uint32_t capacity)
+{
+    semver_cache_t *p_cache;
+    uint32_t shard_capacity;
+    uint32_t num_buckets;
+    int i;
+
+    if(NULL == p2o_cache || 0 == capacity)
+    {
+        return 1;
+    }
+
+    p_cache = (semver_cache_t*)calloc(1, sizeof(semver_cache_t));
+    if(NULL == p_cache)
+    {
+        return 1;
+    }
+
+    shard_capacity = (capacity + SEMVER_CACHE_NUM_SHARDS - 1) / SEMVER_CACHE_NUM_SHARDS;
+
+    //Keep chains short: at least two buckets per entry, power of two.
+    num_buckets = 1;
+    while(num_buckets < 2*shard_capacity)
+    {
+        num_buckets <<= 1;
+    }
+
+    for(i=0;i<SEMVER_CACHE_NUM_SHARDS;i++)
+    {
+        cache_shard_t *p_shard = &p_cache->shards[i];
+
+        pthread_mutex_init(&p_shard->lock, NULL);
+        p_shard->capacity = shard_capacity;
+        p_shard->bucket_mask = num_buckets - 1;
+        p_shard->buckets = (cache_entry_t**)calloc(num_buckets, sizeof(cache_entry_t*));
+        p_shard->ring = (cache_entry_t**)calloc(shard_capacity, sizeof(cache_entry_t*));
+
+        if(NULL == p_shard->buckets || NULL == p_shard->ring)
+        {
+            semver_cache_destroy(p_cache);
+            return 1;
+        }
+    }
+
+    atomic_init(&p_cache->hits, 0);
+    atomic_init(&p_cache->misses, 0);
+    atomic_init(&p_cache->evictions, 0);
+
+    *p2o_cache = p_cache;
+    return 0;
+}
+
+int semver_cache_destroy(semver_cache_t *po_cache)
+{
+    int i;
+    uint32_t j;
+
+    if(NULL == po_cache)
+    {
+        return 1;
+    }
+
+    for(i=0;i<SEMVER_CACHE_NUM_SHARDS;i++)
+    {
+        cache_shard_t *p_shard = &po_cache->shards[i];
+
+        if(NULL != p_shard->ring)
+        {
+            for(j=0;j<p_shard->num_entries;j++)
+            {
+                entry_destroy(p_shard->ring[j]);
+            }
+        }
+        free(p_shard->ring);
+        free(p_shard->buckets);
+        pthread_mutex_destroy(&p_shard->lock);
+    }
+
+    free(po_cache);
+    return 0;
+}
+
+int semver_cache_get(semver_cache_t *p_cache,
+                     const char* semver_str,
+                     uint16_t semver_str_len,
+                     const semver_t **p2o_semver)
+{
+    cache_shard_t *p_shard;
+    cache_entry_t *p_entry;
+    cache_entry_t *p_existing;
+    const semver_t *p_frozen;
+    semver_t parsed;
+    uint32_t hash;
+    int result;
+
+    if(NULL == p_cache || NULL == semver_str || NULL == p2o_semver)
+    {
+        return 1;
+    }
+
+    //The parser stops at the first NUL, so the key must as well.
+    semver_str_len = strnlen(semver_str, semver_str_len);
+    hash = hash_bytes(semver_str, semver_str_len);
+    p_shard = &p_cache->shards[hash % SEMVER_CACHE_NUM_SHARDS];
+
+    pthread_mutex_lock(&p_shard->lock);
+    p_entry = shard_find(p_shard, hash, semver_str, semver_str_len);
+    if(NULL != p_entry)
+    {
+        //Under the lock, so eviction cannot drop the last reference first.
+        p_entry->referenced = true;
+        *p2o_semver = semver_ref(p_entry->p_semver);
+        pthread_mutex_unlock(&p_shard->lock);
+
+        atomic_fetch_add_explicit(&p_cache->hits, 1, memory_order_relaxed);
+        return 0;
+    }
+    pthread_mutex_unlock(&p_shard->lock);
+
+    atomic_fetch_add_explicit(&p_cache->misses, 1, memory_order_relaxed);
+
+    //Parse outside of the lock; invalid strings are never cached.
+    semver_init(&parsed);
+    result = semver_parse_into(&parsed, semver_str, semver_str_len);
+    if(0 == result)
+    {
+        result = semver_freeze(&parsed, &p_frozen);
+    }
+    semver_fini(&parsed);
+    if(0 != result)
+    {
+        return result;
+    }
+
+    p_entry = (cache_entry_t*)malloc(sizeof(cache_entry_t) + semver_str_len);
+    if(NULL == p_entry)
+    {
+        semver_unref(p_frozen);
+        return -1;
+    }
+
+    p_entry->p_semver = p_frozen;
+    p_entry->p_next = NULL;
+    p_entry->referenced = false;
+    p_entry->hash = hash;
+    p_entry->key_len = semver_str_len;
+    memcpy(p_entry->key, semver_str, semver_str_len);
+
+    pthread_mutex_lock(&p_shard->lock);
+    p_existing = shard_find(p_shard, hash, semver_str, semver_str_len);
+    if(NULL != p_existing)
+    {
+        //Somebody else interned it while we were parsing; theirs wins so
+        //that equal strings always share one pointer.
+        *p2o_semver = semver_ref(p_existing->p_semver);
+        pthread_mutex_unlock(&p_shard->lock);
+
+        entry_destroy(p_entry);
+        return 0;
+    }
+    //One reference for the cache, one for the caller.
+    *p2o_semver = semver_ref(p_frozen);
+    shard_insert(p_cache, p_shard, p_entry);
+    pthread_mutex_unlock(&p_shard->lock);
+
+    return 0;
+}
+
+int semver_cache_release(semver_cache_t *p_cache, const semver_t *p_semver)
+{
+    if(NULL == p_cache || NULL == p_semver)
+    {
+        return 1;
+    }
+
+    return semver_unref(p_semver);
+}
+
+int semver_cache_get_stats(semver_cache_t *p_cache,
+                           semver_cache_stats_t *po_stats)
+{
+    int i;
+
+    if(NULL == p_cache || NULL == po_stats)
+    {
+        return 1;
+    }
+
+    po_stats->hits = atomic_load_explicit(&p_cache->hits, memory_order_relaxed);
+    po_stats->misses = atomic_load_explicit(&p_cache->misses, memory_order_relaxed);
+    po_stats->evictions = atomic_load_explicit(&p_cache->evictions, memory_order_relaxed);
+    po_stats->num_entries = 0;
+
+    for(i=0;i<SEMVER_CACHE_NUM_SHARDS;i++)
+    {
+        pthread_mutex_lock(&p_cache->shards[i].lock);
+        po_stats->num_entries += p_cache->shards[i].num_entries;
+        pthread_mutex_unlock(&p_cache->shards[i].lock);
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+//FNV-1a; version strings are short, so this beats anything fancier.
+static uint32_t hash_bytes(const char* str, uint16_t len)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    uint16_t i;
+
+    for(i=0;i<len;i++)
+    {
+        hash ^= (uint8_t)str[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static cache_entry_t* shard_find(cache_shard_t *p_shard,
+                                 uint32_t hash,
+                                 const char* key,
+                                 uint16_t key_len)
+{
+    cache_entry_t *p_entry;
+
+    p_entry = p_shard->buckets[(hash / SEMVER_CACHE_NUM_SHARDS) & p_shard->bucket_mask];
+    while(NULL != p_entry)
+    {
+        if(p_entry->hash == hash &&
+           p_entry->key_len == key_len &&
+           0 == memcmp(p_entry->key, key, key_len))
+        {
+            return p_entry;
+        }
+        p_entry = p_entry->p_next;
+    }
+
+    return NULL;
+}
+
+static void shard_unlink(cache_shard_t *p_shard, cache_entry_t *p_entry)
+{
+    cache_entry_t **pp_link;
+
+    pp_link = &p_shard->buckets[(p_entry->hash / SEMVER_CACHE_NUM_SHARDS) & p_shard->bucket_mask];
+    while(*pp_link != p_entry)
+    {
+        pp_link = &(*pp_link)->p_next;
+    }
+    *pp_link = p_entry->p_next;
+}
+
+//Caller holds the shard lock.
+static void shard_insert(semver_cache_t *p_cache,
+                         cache_shard_t *p_shard,
+                         cache_entry_t *p_entry)
+{
+    uint32_t slot;
+    cache_entry_t **pp_bucket;
+
+    if(p_shard->num_entries < p_shard->capacity)
+    {
+        slot = p_shard->num_entries++;
+    }
+    else
+    {
+        //Second chance: clear referenced bits until an entry that has not
+        //been hit since the hand last passed comes up.
+        while(p_shard->ring[p_shard->hand]->referenced)
+        {
+            p_shard->ring[p_shard->hand]->referenced = false;
+            p_shard->hand = (p_shard->hand + 1) % p_shard->capacity;
+        }
+
+        slot = p_shard->hand;
+        p_shard->hand = (p_shard->hand + 1) % p_shard->capacity;
+
+        shard_unlink(p_shard, p_shard->ring[slot]);
+        entry_destroy(p_shard->ring[slot]);
+        atomic_fetch_add_explicit(&p_cache->evictions, 1, memory_order_relaxed);
+    }
+
+    p_shard->ring[slot] = p_entry;
+
+    pp_bucket = &p_shard->buckets[(p_entry->hash / SEMVER_CACHE_NUM_SHARDS) & p_shard->bucket_mask];
+    p_entry->p_next = *pp_bucket;
+    *pp_bucket = p_entry;
+}
+
+static void entry_destroy(cache_entry_t *p_entry)
+{
+    semver_unref(p_entry->p_semver);
+    free(p_entry);
+}
@@ -0,0 +1,533 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "semver.h"
+#include "semver_codec.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Pre-release text up to this long is reassembled on the stack. */
+#define PR_STACK_BUF_LEN 256
+
+/* Numeric identifiers must leave room for the tag bit. */
+#define MAX_NUMERIC_ID (UINT64_MAX >> 1)
+
+#define IS_DIGIT(c) ((uint8_t)((c) - '0') < 10)
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static size_t varint_size(uint64_t value);
+static size_t varint_put(uint8_t *buf, uint64_t value);
+static int varint_get(const uint8_t *buf,
+                      size_t buf_len,
+                      size_t *pio_pos,
+                      uint64_t *po_value);
+static bool numeric_id_value(const char* id, size_t id_len, uint64_t *po_value);
+static bool is_id_char(uint8_t c);
+static size_t count_pr_identifiers(const semver_t *p_semver);
+static size_t identifier_len(const char* id, const char* pr_end);
+static size_t put_decimal(char* buf, uint64_t value);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_encoded_size(const semver_t *p_semver, size_t *po_size)
+{
+    const char* id;
+    const char* pr_end;
+    size_t id_len;
+    size_t size;
+    uint64_t value;
+
+    if(NULL == p_semver || NULL == po_size)
+    {
+        return 1;
+    }
+
+    size = varint_size(p_semver->major) +
+           varint_size(p_semver->minor) +
+           varint_size(p_semver->patch) +
+           varint_size(((uint64_t)count_pr_identifiers(p_semver) << 1) | 1);
+
+    pr_end = SEMVER_TAIL(p_semver) + p_semver->pr_len;
+    for(id = SEMVER_TAIL(p_semver); 0 != p_semver->pr_len && id <= pr_end; id += id_len + 1)
+    {
+        id_len = identifier_len(id, pr_end);
+
+        if(numeric_id_value(id, id_len, &value))
+        {
+            size += varint_size(value << 1);
+        }
+        else
+        {
+            size += varint_size(((uint64_t)id_len << 1) | 1) + id_len;
+        }
+    }
+
+    if(0 != p_semver->bmd_len)
+    {
+        size += varint_size(p_semver->bmd_len) + p_semver->bmd_len;
+    }
+
+    *po_size = size;
+    return 0;
+}
+
+int semver_encode(const semver_t *p_semver,
+                  uint8_t *buf,
+                  size_t buf_len,
+                  size_t *po_written)
+{
+    const char* id;
+    const char* pr_end;
+    size_t id_len;
+    size_t size;
+    size_t pos = 0;
+    uint64_t value;
+
+    if(NULL == p_semver || NULL == buf || NULL == po_written)
+    {
+        return 1;
+    }
+
+    //Sizing first means the writes below need no bounds checks.
+    if(0 != semver_encoded_size(p_semver, &size) || size > buf_len)
+    {
+        return 1;
+    }
+
+    pos += varint_put(buf + pos, p_semver->major);
+    pos += varint_put(buf + pos, p_semver->minor);
+    pos += varint_put(buf + pos, p_semver->patch);
+    pos += varint_put(buf + pos,
+                      ((uint64_t)count_pr_identifiers(p_semver) << 1) |
+                      (0 != p_semver->bmd_len));
+
+    pr_end = SEMVER_TAIL(p_semver) + p_semver->pr_len;
+    for(id = SEMVER_TAIL(p_semver); 0 != p_semver->pr_len && id <= pr_end; id += id_len + 1)
+    {
+        id_len = identifier_len(id, pr_end);
+
+        if(numeric_id_value(id, id_len, &value))
+        {
+            pos += varint_put(buf + pos, value << 1);
+        }
+        else
+        {
+            pos += varint_put(buf + pos, ((uint64_t)id_len << 1) | 1);
+            memcpy(buf + pos, id, id_len);
+            pos += id_len;
+        }
+    }
+
+    if(0 != p_semver->bmd_len)
+    {
+        pos += varint_put(buf + pos, p_semver->bmd_len);
+        memcpy(buf + pos, SEMVER_TAIL(p_semver) + p_semver->pr_len + 1, p_semver->bmd_len);
+        pos += p_semver->bmd_len;
+    }
+
+    *po_written = pos;
+    return 0;
+}
+
+int semver_decode(const uint8_t *buf,
+                  size_t buf_len,
+                  semver_t **p2o_semver,
+                  size_t *po_read)
+{
+    char stack_pr_str[PR_STACK_BUF_LEN];
+    char* pr_str = stack_pr_str;
+    size_t pr_cap = sizeof(stack_pr_str);
+    size_t pr_len = 0;
+    semver_t *p_semver = NULL;
+    uint64_t major, minor, patch;
+    uint64_t header;
+    uint64_t num_ids;
+    uint64_t tag;
+    uint64_t i;
+    size_t pos = 0;
+    size_t j;
+    int result = 1;
+
+    if(NULL == buf || NULL == p2o_semver || NULL == po_read)
+    {
+        return -1;
+    }
+
+    if(0 != varint_get(buf, buf_len, &pos, &major) ||
+       0 != varint_get(buf, buf_len, &pos, &minor) ||
+       0 != varint_get(buf, buf_len, &pos, &patch) ||
+       0 != varint_get(buf, buf_len, &pos, &header) ||
+       major > UINT32_MAX || minor > UINT32_MAX || patch > UINT32_MAX)
+    {
+        return 1;
+    }
+
+    num_ids = header >> 1;
+    if(num_ids > UINT16_MAX)
+    {
+        return 1;
+    }
+
+    if(0 != semver_create(&p_semver) || NULL == p_semver)
+    {
+        return -1;
+    }
+
+    semver_set_major(p_semver, (uint32_t)major);
+    semver_set_minor(p_semver, (uint32_t)minor);
+    semver_set_patch(p_semver, (uint32_t)patch);
+
+    //Reassemble the dotted pre-release text; every identifier is at most
+    //20 digits or its encoded length, plus a separator.
+    for(i=0;i<num_ids;i++)
+    {
+        size_t id_len;
+
+        if(0 != varint_get(buf, buf_len, &pos, &tag))
+        {
+            goto done;
+        }
+
+        id_len = (tag & 1)? (size_t)(tag >> 1) : 20;
+        if((tag & 1) && (0 == id_len || id_len > buf_len - pos))
+        {
+            goto done;
+        }
+
+        if(pr_len + id_len + 1 > pr_cap)
+        {
+            char* p_grown;
+            size_t new_cap = 2*(pr_len + id_len + 1);
+
+            if(new_cap > UINT16_MAX + 1)
+            {
+                goto done;
+            }
+
+            p_grown = (char*)malloc(new_cap);
+            if(NULL == p_grown)
+            {
+                result = -1;
+                goto done;
+            }
+            memcpy(p_grown, pr_str, pr_len);
+            if(pr_str != stack_pr_str)
+            {
+                free(pr_str);
+            }
+            pr_str = p_grown;
+            pr_cap = new_cap;
+        }
+
+        if(0 != i)
+        {
+            pr_str[pr_len++] = '.';
+        }
+
+        if(tag & 1)
+        {
+            bool numeric = true;
+            uint64_t value;
+
+            for(j=0;j<id_len;j++)
+            {
+                if(!is_id_char(buf[pos + j]))
+                {
+                    goto done;
+                }
+                numeric = numeric && IS_DIGIT(buf[pos + j]);
+            }
+
+            //The encoder only sends a number as text when it is too large
+            //for a tag. Anything else all digits is either not canonical or
+            //not valid at all ("007").
+            if(numeric &&
+               ('0' == buf[pos] ||
+                numeric_id_value((const char*)buf + pos, id_len, &value)))
+            {
+                goto done;
+            }
+            memcpy(pr_str + pr_len, buf + pos, id_len);
+            pr_len += id_len;
+            pos += id_len;
+        }
+        else
+        {
+            pr_len += put_decimal(pr_str + pr_len, tag >> 1);
+        }
+    }
+
+    if(0 != num_ids &&
+       (pr_len > UINT16_MAX ||
+        0 != semver_set_pr_str(p_semver, pr_str, (uint16_t)pr_len)))
+    {
+        goto done;
+    }
+
+    if(header & 1)
+    {
+        uint64_t bmd_len;
+
+        if(0 != varint_get(buf, buf_len, &pos, &bmd_len) ||
+           0 == bmd_len ||
+           bmd_len > UINT16_MAX ||
+           bmd_len > buf_len - pos)
+        {
+            goto done;
+        }
+
+        //Dot separated identifiers, none of them empty.
+        for(j=0;j<bmd_len;j++)
+        {
+            if('.' == buf[pos + j])
+            {
+                if(0 == j || bmd_len - 1 == j || '.' == buf[pos + j - 1])
+                {
+                    goto done;
+                }
+            }
+            else if(!is_id_char(buf[pos + j]))
+            {
+                goto done;
+            }
+        }
+
+        if(0 != semver_set_bmd_str(p_semver, (const char*)buf + pos, (uint16_t)bmd_len))
+        {
+            result = -1;
+            goto done;
+        }
+        pos += bmd_len;
+    }
+
+    result = 0;
+
+done:
+    if(pr_str != stack_pr_str)
+    {
+        free(pr_str);
+    }
+
+    if(0 != result)
+    {
+        semver_destroy(p_semver);
+        return result;
+    }
+
+    *p2o_semver = p_semver;
+    *po_read = pos;
+    return 0;
+}
+
+int semver_encode_many(const semver_t *const *p_semvers,
+                       size_t num_semvers,
+                       uint8_t *buf,
+                       size_t buf_len,
+                       size_t *po_written)
+{
+    size_t pos = 0;
+    size_t written;
+    size_t i;
+
+    if(NULL == p_semvers || NULL == buf || NULL == po_written)
+    {
+        return 1;
+    }
+
+    for(i=0;i<num_semvers;i++)
+    {
+        if(0 != semver_encode(p_semvers[i], buf + pos, buf_len - pos, &written))
+        {
+            return 1;
+        }
+        pos += written;
+    }
+
+    *po_written = pos;
+    return 0;
+}
+
+int semver_decode_many(const uint8_t *buf,
+                       size_t buf_len,
+                       semver_t **p2o_semvers,
+                       size_t num_semvers,
+                       size_t *po_read)
+{
+    size_t pos = 0;
+    size_t read;
+    size_t i;
+    int result;
+
+    if(NULL == buf || NULL == p2o_semvers || NULL == po_read)
+    {
+        return -1;
+    }
+
+    for(i=0;i<num_semvers;i++)
+    {
+        result = semver_decode(buf + pos, buf_len - pos, &p2o_semvers[i], &read);
+        if(0 != result)
+        {
+            while(i--)
+            {
+                semver_destroy(p2o_semvers[i]);
+                p2o_semvers[i] = NULL;
+            }
+            return result;
+        }
+        pos += read;
+    }
+
+    *po_read = pos;
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static size_t varint_size(uint64_t value)
+{
+    size_t size = 1;
+
+    while(value >= 0x80)
+    {
+        value >>= 7;
+        size++;
+    }
+
+    return size;
+}
+
+static size_t varint_put(uint8_t *buf, uint64_t value)
+{
+    size_t size = 0;
+
+    while(value >= 0x80)
+    {
+        buf[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buf[size++] = (uint8_t)value;
+
+    return size;
+}
+
+static int varint_get(const uint8_t *buf,
+                      size_t buf_len,
+                      size_t *pio_pos,
+                      uint64_t *po_value)
+{
+    uint64_t value = 0;
+    size_t pos = *pio_pos;
+    unsigned shift = 0;
+    uint8_t byte;
+
+    do
+    {
+        if(pos >= buf_len || shift >= 7*SEMVER_VARINT_MAX_LEN)
+        {
+            return 1;
+        }
+
+        byte = buf[pos++];
+        if(63 == shift && byte > 1)
+        {
+            //Would overflow 64 bits.
+            return 1;
+        }
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while(byte & 0x80);
+
+    *pio_pos = pos;
+    *po_value = value;
+    return 0;
+}
+
+//Only identifiers which decode back to the exact same text are encoded as
+//numbers, so "0" is numeric but "007" travels as text.
+static bool numeric_id_value(const char* id, size_t id_len, uint64_t *po_value)
+{
+    //Anything that would not come back out identical (leading zeros,
+    //out of range) is kept as text.
+    return 0 == semver_parse_uint(id, id_len, MAX_NUMERIC_ID, po_value);
+}
+
+static size_t count_pr_identifiers(const semver_t *p_semver)
+{
+    const char* pr_str = SEMVER_TAIL(p_semver);
+    size_t count;
+    uint16_t i;
+
+    if(0 == p_semver->pr_len)
+    {
+        return 0;
+    }
+
+    count = 1;
+    for(i=0;i<p_semver->pr_len;i++)
+    {
+        count += ('.' == pr_str[i]);
+    }
+
+    return count;
+}
+
+static size_t identifier_len(const char* id, const char* pr_end)
+{
+    const char* dot = (const char*)memchr(id, '.', pr_end - id);
+
+    return ((NULL == dot)? pr_end : dot) - id;
+}
+
+static bool is_id_char(uint8_t c)
+{
+    return ('0' <= c && c <= '9') ||
+           ('A' <= c && c <= 'Z') ||
+           ('a' <= c && c <= 'z') ||
+           '-' == c;
+}
+
+static size_t put_decimal(char* buf, uint64_t value)
+{
+    char digits[20];
+    size_t num_digits = 0;
+    size_t i;
+
+    do
+    {
+        digits[num_digits++] = '0' + (value % 10);
+        value /= 10;
+    } while(0 != value);
+
+    for(i=0;i<num_digits;i++)
+    {
+        buf[i] = digits[num_digits - 1 - i];
+    }
+
+    return num_digits;
+}
@@ -0,0 +1,152 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "semver.h"
+#include "semver_extract.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define IS_DIGIT(c) ((uint8_t)((c) - '0') < 10)
+#define IS_ALNUM(c) (IS_DIGIT(c) || (uint8_t)(((c) | 0x20) - 'a') < 26)
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static bool try_prefix(const char* str, size_t len);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_extract(const char* buf,
+                   size_t len,
+                   uint32_t flags,
+                   semver_extract_cb_t callback,
+                   void *p_ctx)
+{
+    semver_t semver;
+    semver_match_t match;
+    size_t pos = 0;
+    int result = 0;
+
+    if(NULL == buf || NULL == callback)
+    {
+        return -1;
+    }
+
+    //One semver is reused for every match, so parsing does not allocate
+    //unless a match outgrows the inline storage.
+    semver_init(&semver);
+
+    while(pos < len)
+    {
+        const char* p_dot;
+        size_t dot;
+        size_t start;
+        size_t match_len;
+
+        //Every version has a dot between two digits after its major number.
+        //memchr is vectorized by libc, so text without dots is skipped
+        //many bytes at a time.
+        p_dot = (const char*)memchr(buf + pos, '.', len - pos);
+        if(NULL == p_dot)
+        {
+            break;
+        }
+        dot = p_dot - buf;
+
+        if(dot == pos || !IS_DIGIT(buf[dot - 1]) ||
+           dot + 1 == len || !IS_DIGIT(buf[dot + 1]))
+        {
+            pos = dot + 1;
+            continue;
+        }
+
+        start = dot - 1;
+        while(start > pos && IS_DIGIT(buf[start - 1]))
+        {
+            start--;
+        }
+
+        //Never start in the middle of a number.
+        match_len = 0;
+        if(0 == start || !IS_DIGIT(buf[start - 1]))
+        {
+            match_len = semver_longest_prefix(buf + start, len - start);
+        }
+
+        //The grammar accepts any run of digits, so the longest run it
+        //accepts can still fail the range and leading zero checks. Any
+        //shorter prefix would end in the middle of a number ("1.2.00" holds
+        //"1.2.0"), which is not a version that occurs in the text, so there
+        //is no match at all. Nor is there one that runs on into a word, as
+        //in "1.2.3rc1".
+        if(0 != match_len &&
+           (!try_prefix(buf + start, match_len) ||
+            (start + match_len < len && IS_ALNUM(buf[start + match_len]))))
+        {
+            match_len = 0;
+        }
+
+        if(0 == match_len)
+        {
+            pos = dot + 1;
+            continue;
+        }
+
+        match.off = start;
+        match.len = match_len;
+        match.p_semver = NULL;
+
+        if(flags & SEMVER_EXTRACT_PARSE)
+        {
+            if(0 != semver_parse_into(&semver, buf + start, match_len))
+            {
+                result = -1;
+                break;
+            }
+            match.p_semver = &semver;
+        }
+
+        if(0 != callback(p_ctx, &match))
+        {
+            result = 1;
+            break;
+        }
+
+        pos = start + match_len;
+    }
+
+    semver_fini(&semver);
+    return result;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static bool try_prefix(const char* str, size_t len)
+{
+    semver_parts_t parts;
+
+    return 0 == semver_parse_parts(str, len, &parts);
+}
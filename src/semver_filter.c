@@ -0,0 +1,392 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "semver.h"
+#include "semver_batch.h"
+#include "semver_filter.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Rows per mask word, and so per pass of the inner loop. */
+#define WORD_ROWS 64
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/* A bound broadcast to every lane. */
+typedef struct bound_lanes_
+{
+    semver_lanes_t major;
+    semver_lanes_t minor;
+    semver_lanes_t patch;
+} bound_lanes_t;
+
+/* A block of SEMVER_LANES rows, loaded from the columns. */
+typedef struct block_
+{
+    semver_lanes_t major;
+    semver_lanes_t minor;
+    semver_lanes_t patch;
+    semver_lane_mask_t has_pr;
+} block_t;
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void compile_bound(semver_bound_t *po_bound, const semver_t *p_semver, bool inclusive);
+static void broadcast(bound_lanes_t *po_lanes, const semver_bound_t *p_bound);
+static void block_admit(const semver_bound_t *p_bound,
+                        const bound_lanes_t *p_lanes,
+                        bool is_lo,
+                        const block_t *p_block,
+                        semver_lane_mask_t *p_in,
+                        semver_lane_mask_t *p_ties);
+static uint32_t lane_bits(const semver_lane_mask_t *p_mask);
+static int row_cmp(const semver_batch_t *p_batch,
+                   const char* buf,
+                   size_t row,
+                   const semver_bound_t *p_bound);
+static bool row_in(const semver_batch_t *p_batch,
+                   const char* buf,
+                   size_t row,
+                   const semver_interval_t *p_interval);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_interval_compile(semver_interval_t *po_interval,
+                            const semver_t *p_lo,
+                            const semver_t *p_hi,
+                            uint32_t flags)
+{
+    if(NULL == po_interval)
+    {
+        return 1;
+    }
+
+    memset(po_interval, 0, sizeof(semver_interval_t));
+
+    if(NULL != p_lo)
+    {
+        compile_bound(&po_interval->lo, p_lo, 0 == (flags & SEMVER_INTERVAL_LO_EXCLUSIVE));
+    }
+
+    if(NULL != p_hi)
+    {
+        compile_bound(&po_interval->hi, p_hi, 0 != (flags & SEMVER_INTERVAL_HI_INCLUSIVE));
+    }
+
+    return 0;
+}
+
+int semver_batch_filter(const semver_batch_t *p_batch,
+                        const char* buf,
+                        const semver_interval_t *p_interval,
+                        uint64_t *po_mask,
+                        size_t *po_num_matches)
+{
+    bound_lanes_t lo_lanes;
+    bound_lanes_t hi_lanes;
+    size_t num_matches = 0;
+    size_t num_words;
+    size_t word;
+    size_t row;
+
+    if(NULL == p_batch || NULL == buf || NULL == p_interval || NULL == po_mask)
+    {
+        return 1;
+    }
+
+    broadcast(&lo_lanes, &p_interval->lo);
+    broadcast(&hi_lanes, &p_interval->hi);
+
+    //Whole words a block at a time.
+    num_words = p_batch->count / WORD_ROWS;
+    for(word=0;word<num_words;word++)
+    {
+        uint64_t bits = 0;
+        uint64_t ties = 0;
+        int block;
+
+        for(block=0;block<WORD_ROWS/SEMVER_LANES;block++)
+        {
+            block_t rows;
+            semver_lanes16_t pr_len;
+            semver_lanes8_t status;
+            semver_lane_mask_t in;
+            semver_lane_mask_t block_ties = { 0 };
+
+            row = word * WORD_ROWS + block * SEMVER_LANES;
+            memcpy(&rows.major, &p_batch->major[row], sizeof(rows.major));
+            memcpy(&rows.minor, &p_batch->minor[row], sizeof(rows.minor));
+            memcpy(&rows.patch, &p_batch->patch[row], sizeof(rows.patch));
+            memcpy(&pr_len, &p_batch->pr_len[row], sizeof(pr_len));
+            memcpy(&status, &p_batch->status[row], sizeof(status));
+
+            rows.has_pr = (__builtin_convertvector(pr_len, semver_lanes_t) != 0);
+            in = (__builtin_convertvector(status, semver_lanes_t) == 0);
+
+            if(p_interval->lo.present)
+            {
+                block_admit(&p_interval->lo, &lo_lanes, true, &rows, &in, &block_ties);
+            }
+            if(p_interval->hi.present)
+            {
+                block_admit(&p_interval->hi, &hi_lanes, false, &rows, &in, &block_ties);
+            }
+
+            bits |= (uint64_t)lane_bits(&in) << (block * SEMVER_LANES);
+            ties |= (uint64_t)lane_bits(&block_ties) << (block * SEMVER_LANES);
+        }
+
+        //Pre-release ties with a bound take the scalar path.
+        while(0 != ties)
+        {
+            int bit = __builtin_ctzll(ties);
+
+            bits &= ~(1ull << bit);
+            bits |= (uint64_t)row_in(p_batch, buf, word * WORD_ROWS + bit, p_interval) << bit;
+            ties &= ties - 1;
+        }
+
+        po_mask[word] = bits;
+        num_matches += __builtin_popcountll(bits);
+    }
+
+    //The rows of a last, partial word.
+    if(num_words < SEMVER_MASK_WORDS(p_batch->count))
+    {
+        uint64_t bits = 0;
+
+        for(row=num_words*WORD_ROWS;row<p_batch->count;row++)
+        {
+            bits |= (uint64_t)row_in(p_batch, buf, row, p_interval) << (row % WORD_ROWS);
+        }
+
+        po_mask[num_words] = bits;
+        num_matches += __builtin_popcountll(bits);
+    }
+
+    if(NULL != po_num_matches)
+    {
+        *po_num_matches = num_matches;
+    }
+
+    return 0;
+}
+
+size_t semver_mask_to_rows(const uint64_t *p_mask, size_t count, size_t *po_rows)
+{
+    size_t num_rows = 0;
+    size_t word;
+    uint64_t bits;
+
+    if(NULL == p_mask || NULL == po_rows)
+    {
+        return 0;
+    }
+
+    for(word=0;word<SEMVER_MASK_WORDS(count);word++)
+    {
+        bits = p_mask[word];
+
+        //Bits past count are never set by semver_batch_filter, but do not
+        //trust the caller's padding.
+        if(word == count / WORD_ROWS)
+        {
+            bits &= (1ull << (count % WORD_ROWS)) - 1;
+        }
+
+        while(0 != bits)
+        {
+            po_rows[num_rows++] = word * WORD_ROWS + __builtin_ctzll(bits);
+            bits &= bits - 1;
+        }
+    }
+
+    return num_rows;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static void compile_bound(semver_bound_t *po_bound, const semver_t *p_semver, bool inclusive)
+{
+    po_bound->major = p_semver->major;
+    po_bound->minor = p_semver->minor;
+    po_bound->patch = p_semver->patch;
+    po_bound->pr = SEMVER_TAIL(p_semver);
+    po_bound->pr_len = p_semver->pr_len;
+    po_bound->present = 1;
+    po_bound->inclusive = inclusive;
+}
+
+static void broadcast(bound_lanes_t *po_lanes, const semver_bound_t *p_bound)
+{
+    int i;
+
+    for(i=0;i<SEMVER_LANES;i++)
+    {
+        po_lanes->major[i] = p_bound->major;
+        po_lanes->minor[i] = p_bound->minor;
+        po_lanes->patch[i] = p_bound->patch;
+    }
+}
+
+//Clears the lanes of p_in the bound does not let through: those below a
+//lower bound or above an upper one. Lanes whose core ties with the bound
+//while both carry a pre-release cannot be decided here; they are let
+//through and added to p_ties for the scalar path.
+static void block_admit(const semver_bound_t *p_bound,
+                        const bound_lanes_t *p_lanes,
+                        bool is_lo,
+                        const block_t *p_block,
+                        semver_lane_mask_t *p_in,
+                        semver_lane_mask_t *p_ties)
+{
+    semver_lane_mask_t major_eq = (p_block->major == p_lanes->major);
+    semver_lane_mask_t minor_eq = (p_block->minor == p_lanes->minor);
+    semver_lane_mask_t lt;
+    semver_lane_mask_t gt;
+    semver_lane_mask_t eq;
+    semver_lane_mask_t ties = { 0 };
+
+    lt = (p_block->major < p_lanes->major) |
+         (major_eq & ((p_block->minor < p_lanes->minor) |
+                      (minor_eq & (p_block->patch < p_lanes->patch))));
+    gt = (p_block->major > p_lanes->major) |
+         (major_eq & ((p_block->minor > p_lanes->minor) |
+                      (minor_eq & (p_block->patch > p_lanes->patch))));
+    eq = ~(lt | gt);
+
+    if(0 == p_bound->pr_len)
+    {
+        //A pre-release precedes the release of its version.
+        lt |= eq & p_block->has_pr;
+        eq &= ~p_block->has_pr;
+    }
+    else
+    {
+        //A release follows every pre-release of its version; two
+        //pre-releases need their text compared.
+        gt |= eq & ~p_block->has_pr;
+        ties = eq & p_block->has_pr;
+        eq = (semver_lane_mask_t){ 0 };
+    }
+
+    if(!p_bound->inclusive)
+    {
+        eq = (semver_lane_mask_t){ 0 };
+    }
+
+    *p_ties |= ties;
+    *p_in &= (is_lo? gt : lt) | eq | ties;
+}
+
+#if defined(__AVX2__)
+static uint32_t lane_bits(const semver_lane_mask_t *p_mask)
+{
+    return (uint32_t)_mm256_movemask_ps((__m256)*p_mask);
+}
+#elif defined(__SSE2__)
+static uint32_t lane_bits(const semver_lane_mask_t *p_mask)
+{
+    return (uint32_t)_mm_movemask_ps((__m128)*p_mask);
+}
+#else
+static uint32_t lane_bits(const semver_lane_mask_t *p_mask)
+{
+    uint32_t bits = 0;
+    int i;
+
+    for(i=0;i<SEMVER_LANES;i++)
+    {
+        bits |= (uint32_t)((*p_mask)[i] & 1) << i;
+    }
+
+    return bits;
+}
+#endif
+
+static int row_cmp(const semver_batch_t *p_batch,
+                   const char* buf,
+                   size_t row,
+                   const semver_bound_t *p_bound)
+{
+    if(p_batch->major[row] != p_bound->major)
+    {
+        return (p_batch->major[row] < p_bound->major)? -1 : 1;
+    }
+    if(p_batch->minor[row] != p_bound->minor)
+    {
+        return (p_batch->minor[row] < p_bound->minor)? -1 : 1;
+    }
+    if(p_batch->patch[row] != p_bound->patch)
+    {
+        return (p_batch->patch[row] < p_bound->patch)? -1 : 1;
+    }
+
+    return semver_pr_str_cmp(buf + p_batch->line_off[row] + p_batch->pr_off[row],
+                             p_batch->pr_len[row],
+                             p_bound->pr, p_bound->pr_len);
+}
+
+static bool row_in(const semver_batch_t *p_batch,
+                   const char* buf,
+                   size_t row,
+                   const semver_interval_t *p_interval)
+{
+    int cmp;
+
+    if(0 != p_batch->status[row])
+    {
+        return false;
+    }
+
+    if(p_interval->lo.present)
+    {
+        cmp = row_cmp(p_batch, buf, row, &p_interval->lo);
+        if(cmp < 0 || (0 == cmp && !p_interval->lo.inclusive))
+        {
+            return false;
+        }
+    }
+
+    if(p_interval->hi.present)
+    {
+        cmp = row_cmp(p_batch, buf, row, &p_interval->hi);
+        if(cmp > 0 || (0 == cmp && !p_interval->hi.inclusive))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
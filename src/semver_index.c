@@ -0,0 +1,760 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "semver.h"
+#include "semver_index.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define INDEX_MAGIC          "SEMVIDX"
+#define INDEX_FORMAT_VERSION 2
+#define INDEX_BYTE_ORDER     0x01020304u
+
+/* Appended to the index path to make the temporary file it is written to
+ * before being renamed into place. */
+#define TMP_SUFFIX ".XXXXXX"
+
+/* Every column starts on a multiple of this. */
+#define COL_ALIGN 8
+
+/* Rows are ordered, and searched, on a precomputed two word key: major and
+ * minor in the high word, patch and a "no pre-release" bit in the low one.
+ * Only rows whose keys tie and that are pre-releases need their text
+ * compared. */
+#define KEY_HI(p_semver) (((uint64_t)(p_semver)->major << 32) | (p_semver)->minor)
+#define KEY_LO(p_semver) (((uint64_t)(p_semver)->patch << 1) | (0 == (p_semver)->pr_len))
+#define KEY_IS_PR(lo)    (0 == ((lo) & 1))
+
+#define MIN(a,b) (((a)<(b))?(a):(b))
+#define CMP(a,b) (((a)>(b)) - ((a)<(b)))
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef enum index_col_
+{
+    COL_PKG_OFF,
+    COL_PKG_LEN,
+    COL_KEY_HI,
+    COL_KEY_LO,
+    COL_PR_OFF,
+    COL_PR_LEN,
+    COL_BMD_OFF,
+    COL_BMD_LEN,
+    NUM_COLS
+} index_col_t;
+
+typedef struct index_header_
+{
+    char magic[8];
+    uint32_t format_version;
+    uint32_t byte_order;
+    uint32_t num_rows;
+    uint32_t reserved;
+    uint64_t pool_off;
+    uint64_t pool_len;
+    uint64_t col_off[NUM_COLS];
+} index_header_t;
+
+struct semver_index_
+{
+    void *p_map;
+    size_t map_len;
+
+    uint32_t num_rows;
+    const char* pool;
+    uint64_t pool_len;
+
+    const uint32_t *pkg_off;
+    const uint16_t *pkg_len;
+    const uint64_t *key_hi;
+    const uint64_t *key_lo;
+    const uint32_t *pr_off;
+    const uint16_t *pr_len;
+    const uint32_t *bmd_off;
+    const uint16_t *bmd_len;
+};
+
+typedef struct sort_row_
+{
+    const semver_index_row_t *p_row;
+    uint64_t key_hi;
+    uint64_t key_lo;
+    uint32_t input_pos;
+} sort_row_t;
+
+typedef struct pool_
+{
+    char* buf;
+    size_t len;
+    size_t cap;
+} pool_t;
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static const size_t g_col_size[NUM_COLS] =
+{
+    sizeof(uint32_t), //COL_PKG_OFF
+    sizeof(uint16_t), //COL_PKG_LEN
+    sizeof(uint64_t), //COL_KEY_HI
+    sizeof(uint64_t), //COL_KEY_LO
+    sizeof(uint32_t), //COL_PR_OFF
+    sizeof(uint16_t), //COL_PR_LEN
+    sizeof(uint32_t), //COL_BMD_OFF
+    sizeof(uint16_t), //COL_BMD_LEN
+};
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static int sort_row_cmp(const void *p_a, const void *p_b);
+static int bytes_cmp(const char* a, size_t len_a, const char* b, size_t len_b);
+static int pool_append(pool_t *p_pool, const char* str, size_t len, uint32_t *po_off);
+static int pool_append_pr(pool_t *p_pool, const semver_t *p_semver,
+                          uint32_t *po_off, uint16_t *po_len);
+static int write_padded(FILE *p_file, const void *p_data, size_t len);
+static int row_cmp(const semver_index_t *p_index,
+                   uint32_t row,
+                   uint64_t key_hi,
+                   uint64_t key_lo,
+                   const semver_t *p_semver);
+static void pkg_bounds(const semver_index_t *p_index,
+                       const char* pkg,
+                       uint16_t pkg_len,
+                       uint32_t *po_first,
+                       uint32_t *po_end);
+static uint32_t version_lower_bound(const semver_index_t *p_index,
+                                    uint32_t first,
+                                    uint32_t end,
+                                    const semver_t *p_semver);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_index_write(const char* path,
+                       const semver_index_row_t *rows,
+                       uint32_t num_rows)
+{
+    index_header_t header;
+    sort_row_t *sorted = NULL;
+    void *cols[NUM_COLS] = { NULL };
+    pool_t pool = { NULL, 0, 0 };
+    FILE *p_file = NULL;
+    char* tmp_path = NULL;
+    bool tmp_created = false;
+    struct stat file_stat;
+    mode_t mode;
+    uint64_t off;
+    uint32_t i;
+    int fd;
+    int c;
+    int result = 1;
+
+    if(NULL == path || (NULL == rows && 0 != num_rows))
+    {
+        return 1;
+    }
+
+    for(i=0;i<num_rows;i++)
+    {
+        if(NULL == rows[i].pkg || NULL == rows[i].p_semver)
+        {
+            return 1;
+        }
+    }
+
+    sorted = (sort_row_t*)malloc((num_rows + 1) * sizeof(sort_row_t));
+    if(NULL == sorted)
+    {
+        return 1;
+    }
+
+    for(c=0;c<NUM_COLS;c++)
+    {
+        cols[c] = malloc((num_rows + 1) * g_col_size[c]);
+        if(NULL == cols[c])
+        {
+            goto done;
+        }
+    }
+
+    for(i=0;i<num_rows;i++)
+    {
+        sorted[i].p_row = &rows[i];
+        sorted[i].key_hi = KEY_HI(rows[i].p_semver);
+        sorted[i].key_lo = KEY_LO(rows[i].p_semver);
+        sorted[i].input_pos = i;
+    }
+    qsort(sorted, num_rows, sizeof(sort_row_t), sort_row_cmp);
+
+    for(i=0;i<num_rows;i++)
+    {
+        const semver_index_row_t *p_row = sorted[i].p_row;
+        const semver_t *p_semver = p_row->p_semver;
+        const char* bmd_str = (0 != p_semver->bmd_len)?
+                              SEMVER_TAIL(p_semver) + p_semver->pr_len + 1 : NULL;
+        uint32_t pkg_off;
+
+        //Rows are grouped by package, so each name is stored once.
+        if(0 != i &&
+           0 == bytes_cmp(p_row->pkg, p_row->pkg_len,
+                          sorted[i-1].p_row->pkg, sorted[i-1].p_row->pkg_len))
+        {
+            pkg_off = ((uint32_t*)cols[COL_PKG_OFF])[i-1];
+        }
+        else if(0 != pool_append(&pool, p_row->pkg, p_row->pkg_len, &pkg_off))
+        {
+            goto done;
+        }
+
+        ((uint32_t*)cols[COL_PKG_OFF])[i] = pkg_off;
+        ((uint16_t*)cols[COL_PKG_LEN])[i] = p_row->pkg_len;
+        ((uint64_t*)cols[COL_KEY_HI])[i] = sorted[i].key_hi;
+        ((uint64_t*)cols[COL_KEY_LO])[i] = sorted[i].key_lo;
+
+        if(0 != pool_append_pr(&pool, p_semver,
+                               &((uint32_t*)cols[COL_PR_OFF])[i],
+                               &((uint16_t*)cols[COL_PR_LEN])[i]) ||
+           0 != pool_append(&pool, bmd_str, p_semver->bmd_len,
+                            &((uint32_t*)cols[COL_BMD_OFF])[i]))
+        {
+            goto done;
+        }
+        ((uint16_t*)cols[COL_BMD_LEN])[i] = p_semver->bmd_len;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.format_version = INDEX_FORMAT_VERSION;
+    header.byte_order = INDEX_BYTE_ORDER;
+    header.num_rows = num_rows;
+    header.pool_len = pool.len;
+
+    off = sizeof(header);
+    for(c=0;c<NUM_COLS;c++)
+    {
+        header.col_off[c] = off;
+        off += (num_rows * g_col_size[c] + COL_ALIGN - 1) & ~(uint64_t)(COL_ALIGN - 1);
+    }
+    header.pool_off = off;
+
+    //Readers keep the old file mapped, so it must never be truncated or
+    //written over: the new index goes to a temporary file next to it, which
+    //is then renamed over it in one step.
+    tmp_path = (char*)malloc(strlen(path) + sizeof(TMP_SUFFIX));
+    if(NULL == tmp_path)
+    {
+        goto done;
+    }
+    strcpy(tmp_path, path);
+    strcat(tmp_path, TMP_SUFFIX);
+
+    fd = mkstemp(tmp_path);
+    if(fd < 0)
+    {
+        goto done;
+    }
+    tmp_created = true;
+
+    //mkstemp makes the file private to its owner; keep the permissions of
+    //the index being replaced, or make a new one world readable.
+    mode = (0 == stat(path, &file_stat))? (file_stat.st_mode & 0777) : 0644;
+    p_file = (0 == fchmod(fd, mode))? fdopen(fd, "wb") : NULL;
+    if(NULL == p_file)
+    {
+        close(fd);
+        goto done;
+    }
+
+    if(0 != write_padded(p_file, &header, sizeof(header)))
+    {
+        goto done;
+    }
+    for(c=0;c<NUM_COLS;c++)
+    {
+        if(0 != write_padded(p_file, cols[c], num_rows * g_col_size[c]))
+        {
+            goto done;
+        }
+    }
+    if(pool.len != fwrite(pool.buf, 1, pool.len, p_file))
+    {
+        goto done;
+    }
+
+    //On disk before it becomes visible under path.
+    if(0 != fflush(p_file) || 0 != fsync(fileno(p_file)))
+    {
+        goto done;
+    }
+
+    c = fclose(p_file);
+    p_file = NULL;
+    if(0 != c || 0 != rename(tmp_path, path))
+    {
+        goto done;
+    }
+    tmp_created = false;
+
+    result = 0;
+
+done:
+    if(NULL != p_file)
+    {
+        fclose(p_file);
+    }
+    if(tmp_created)
+    {
+        unlink(tmp_path);
+    }
+    free(tmp_path);
+    for(c=0;c<NUM_COLS;c++)
+    {
+        free(cols[c]);
+    }
+    free(pool.buf);
+    free(sorted);
+
+    return result;
+}
+
+int semver_index_open(const char* path, semver_index_t **p2o_index)
+{
+    semver_index_t *p_index = NULL;
+    const index_header_t *p_header;
+    const void *cols[NUM_COLS];
+    struct stat file_stat;
+    void *p_map;
+    int fd;
+    int c;
+
+    if(NULL == path || NULL == p2o_index)
+    {
+        return -1;
+    }
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0)
+    {
+        return -1;
+    }
+
+    if(0 != fstat(fd, &file_stat))
+    {
+        close(fd);
+        return -1;
+    }
+
+    if((size_t)file_stat.st_size < sizeof(index_header_t))
+    {
+        close(fd);
+        return 1;
+    }
+
+    p_map = mmap(NULL, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(MAP_FAILED == p_map)
+    {
+        return -1;
+    }
+
+    //Only the header and the column extents are checked up front; string
+    //spans are checked as rows are read, so opening never touches row data.
+    p_header = (const index_header_t*)p_map;
+    if(0 != memcmp(p_header->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) ||
+       INDEX_FORMAT_VERSION != p_header->format_version ||
+       INDEX_BYTE_ORDER != p_header->byte_order ||
+       p_header->pool_off > (uint64_t)file_stat.st_size ||
+       p_header->pool_len > (uint64_t)file_stat.st_size - p_header->pool_off)
+    {
+        munmap(p_map, file_stat.st_size);
+        return 1;
+    }
+
+    for(c=0;c<NUM_COLS;c++)
+    {
+        uint64_t col_len = (uint64_t)p_header->num_rows * g_col_size[c];
+
+        if(0 != p_header->col_off[c] % COL_ALIGN ||
+           p_header->col_off[c] > (uint64_t)file_stat.st_size ||
+           col_len > (uint64_t)file_stat.st_size - p_header->col_off[c])
+        {
+            munmap(p_map, file_stat.st_size);
+            return 1;
+        }
+        cols[c] = (const char*)p_map + p_header->col_off[c];
+    }
+
+    p_index = (semver_index_t*)malloc(sizeof(semver_index_t));
+    if(NULL == p_index)
+    {
+        munmap(p_map, file_stat.st_size);
+        return -1;
+    }
+
+    p_index->p_map = p_map;
+    p_index->map_len = file_stat.st_size;
+    p_index->num_rows = p_header->num_rows;
+    p_index->pool = (const char*)p_map + p_header->pool_off;
+    p_index->pool_len = p_header->pool_len;
+    p_index->pkg_off = (const uint32_t*)cols[COL_PKG_OFF];
+    p_index->pkg_len = (const uint16_t*)cols[COL_PKG_LEN];
+    p_index->key_hi = (const uint64_t*)cols[COL_KEY_HI];
+    p_index->key_lo = (const uint64_t*)cols[COL_KEY_LO];
+    p_index->pr_off = (const uint32_t*)cols[COL_PR_OFF];
+    p_index->pr_len = (const uint16_t*)cols[COL_PR_LEN];
+    p_index->bmd_off = (const uint32_t*)cols[COL_BMD_OFF];
+    p_index->bmd_len = (const uint16_t*)cols[COL_BMD_LEN];
+
+    *p2o_index = p_index;
+    return 0;
+}
+
+int semver_index_close(semver_index_t *po_index)
+{
+    if(NULL == po_index)
+    {
+        return 1;
+    }
+
+    munmap(po_index->p_map, po_index->map_len);
+    free(po_index);
+
+    return 0;
+}
+
+uint32_t semver_index_num_rows(const semver_index_t *p_index)
+{
+    if(NULL == p_index)
+    {
+        return 0;
+    }
+
+    return p_index->num_rows;
+}
+
+int semver_index_get(const semver_index_t *p_index,
+                     uint32_t row,
+                     semver_index_entry_t *po_entry)
+{
+    if(NULL == p_index || NULL == po_entry || row >= p_index->num_rows)
+    {
+        return 1;
+    }
+
+    if((uint64_t)p_index->pkg_off[row] + p_index->pkg_len[row] > p_index->pool_len ||
+       (uint64_t)p_index->pr_off[row] + p_index->pr_len[row] > p_index->pool_len ||
+       (uint64_t)p_index->bmd_off[row] + p_index->bmd_len[row] > p_index->pool_len)
+    {
+        return 1;
+    }
+
+    po_entry->pkg = p_index->pool + p_index->pkg_off[row];
+    po_entry->pkg_len = p_index->pkg_len[row];
+    po_entry->major = (uint32_t)(p_index->key_hi[row] >> 32);
+    po_entry->minor = (uint32_t)p_index->key_hi[row];
+    po_entry->patch = (uint32_t)(p_index->key_lo[row] >> 1);
+    po_entry->pr_str = p_index->pool + p_index->pr_off[row];
+    po_entry->pr_str_len = p_index->pr_len[row];
+    po_entry->bmd_str = p_index->pool + p_index->bmd_off[row];
+    po_entry->bmd_str_len = p_index->bmd_len[row];
+
+    return 0;
+}
+
+int semver_index_lookup(const semver_index_t *p_index,
+                        const char* pkg,
+                        uint16_t pkg_len,
+                        const semver_t *p_semver,
+                        uint32_t *po_row)
+{
+    uint32_t first;
+    uint32_t end;
+    uint32_t row;
+
+    if(NULL == p_index || NULL == pkg || NULL == p_semver || NULL == po_row)
+    {
+        return -1;
+    }
+
+    pkg_bounds(p_index, pkg, pkg_len, &first, &end);
+    row = version_lower_bound(p_index, first, end, p_semver);
+
+    if(row == end || 0 != row_cmp(p_index, row, KEY_HI(p_semver), KEY_LO(p_semver), p_semver))
+    {
+        return 1;
+    }
+
+    *po_row = row;
+    return 0;
+}
+
+int semver_index_range(const semver_index_t *p_index,
+                       const char* pkg,
+                       uint16_t pkg_len,
+                       const semver_t *p_lo,
+                       const semver_t *p_hi,
+                       uint32_t *po_first,
+                       uint32_t *po_end)
+{
+    uint32_t first;
+    uint32_t end;
+
+    if(NULL == p_index || NULL == pkg || NULL == po_first || NULL == po_end)
+    {
+        return 1;
+    }
+
+    pkg_bounds(p_index, pkg, pkg_len, &first, &end);
+
+    if(NULL != p_lo)
+    {
+        first = version_lower_bound(p_index, first, end, p_lo);
+    }
+    if(NULL != p_hi)
+    {
+        end = version_lower_bound(p_index, first, end, p_hi);
+    }
+
+    *po_first = first;
+    *po_end = end;
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static int sort_row_cmp(const void *p_a, const void *p_b)
+{
+    const sort_row_t *p_sa = (const sort_row_t*)p_a;
+    const sort_row_t *p_sb = (const sort_row_t*)p_b;
+    const semver_t *p_semver_a = p_sa->p_row->p_semver;
+    const semver_t *p_semver_b = p_sb->p_row->p_semver;
+    int result;
+
+    result = bytes_cmp(p_sa->p_row->pkg, p_sa->p_row->pkg_len,
+                       p_sb->p_row->pkg, p_sb->p_row->pkg_len);
+    if(0 != result)
+    {
+        return result;
+    }
+
+    if(p_sa->key_hi != p_sb->key_hi)
+    {
+        return CMP(p_sa->key_hi, p_sb->key_hi);
+    }
+    if(p_sa->key_lo != p_sb->key_lo)
+    {
+        return CMP(p_sa->key_lo, p_sb->key_lo);
+    }
+
+    if(KEY_IS_PR(p_sa->key_lo))
+    {
+        result = semver_pr_str_cmp(SEMVER_TAIL(p_semver_a), p_semver_a->pr_len,
+                                   SEMVER_TAIL(p_semver_b), p_semver_b->pr_len);
+        if(0 != result)
+        {
+            return result;
+        }
+    }
+
+    //qsort is not stable; fall back on input order.
+    return CMP(p_sa->input_pos, p_sb->input_pos);
+}
+
+static int bytes_cmp(const char* a, size_t len_a, const char* b, size_t len_b)
+{
+    int result = memcmp(a, b, MIN(len_a, len_b));
+
+    return (0 != result)? result : CMP(len_a, len_b);
+}
+
+static int pool_append(pool_t *p_pool, const char* str, size_t len, uint32_t *po_off)
+{
+    if(p_pool->len + len > UINT32_MAX)
+    {
+        return 1;
+    }
+
+    if(p_pool->len + len > p_pool->cap)
+    {
+        size_t new_cap = MIN(2*(p_pool->len + len) + 64, (size_t)UINT32_MAX);
+        char* p_grown = (char*)realloc(p_pool->buf, new_cap);
+
+        if(NULL == p_grown)
+        {
+            return 1;
+        }
+        p_pool->buf = p_grown;
+        p_pool->cap = new_cap;
+    }
+
+    if(0 != len)
+    {
+        memcpy(p_pool->buf + p_pool->len, str, len);
+    }
+    *po_off = p_pool->len;
+    p_pool->len += len;
+
+    return 0;
+}
+
+static int pool_append_pr(pool_t *p_pool, const semver_t *p_semver,
+                          uint32_t *po_off, uint16_t *po_len)
+{
+    //Stored dotted already, so this is a plain copy.
+    if(0 != pool_append(p_pool, SEMVER_TAIL(p_semver), p_semver->pr_len, po_off))
+    {
+        return 1;
+    }
+
+    *po_len = p_semver->pr_len;
+    return 0;
+}
+
+static int write_padded(FILE *p_file, const void *p_data, size_t len)
+{
+    static const char zeros[COL_ALIGN] = { 0 };
+    size_t pad = (COL_ALIGN - len % COL_ALIGN) % COL_ALIGN;
+
+    if(len != fwrite(p_data, 1, len, p_file) ||
+       pad != fwrite(zeros, 1, pad, p_file))
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+//Precedence of a row relative to p_semver, whose key is given: -1, 0 or 1.
+static int row_cmp(const semver_index_t *p_index,
+                   uint32_t row,
+                   uint64_t key_hi,
+                   uint64_t key_lo,
+                   const semver_t *p_semver)
+{
+    if(p_index->key_hi[row] != key_hi)
+    {
+        return CMP(p_index->key_hi[row], key_hi);
+    }
+    if(p_index->key_lo[row] != key_lo)
+    {
+        return CMP(p_index->key_lo[row], key_lo);
+    }
+    if(!KEY_IS_PR(key_lo))
+    {
+        return 0;
+    }
+
+    //A corrupt span compares as "no pre-release" rather than reading past
+    //the pool.
+    if((uint64_t)p_index->pr_off[row] + p_index->pr_len[row] > p_index->pool_len)
+    {
+        return -semver_pr_cmp_str(p_semver, "", 0);
+    }
+
+    return -semver_pr_cmp_str(p_semver,
+                              p_index->pool + p_index->pr_off[row],
+                              p_index->pr_len[row]);
+}
+
+static void pkg_bounds(const semver_index_t *p_index,
+                       const char* pkg,
+                       uint16_t pkg_len,
+                       uint32_t *po_first,
+                       uint32_t *po_end)
+{
+    uint32_t lo = 0;
+    uint32_t hi = p_index->num_rows;
+    uint32_t mid;
+    int result;
+
+    //Lower bound...
+    while(lo < hi)
+    {
+        mid = lo + (hi - lo)/2;
+        result = ((uint64_t)p_index->pkg_off[mid] + p_index->pkg_len[mid] > p_index->pool_len)? 1:
+                 bytes_cmp(p_index->pool + p_index->pkg_off[mid], p_index->pkg_len[mid],
+                           pkg, pkg_len);
+        if(result < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    *po_first = lo;
+
+    //...and upper bound.
+    hi = p_index->num_rows;
+    while(lo < hi)
+    {
+        mid = lo + (hi - lo)/2;
+        result = ((uint64_t)p_index->pkg_off[mid] + p_index->pkg_len[mid] > p_index->pool_len)? 1:
+                 bytes_cmp(p_index->pool + p_index->pkg_off[mid], p_index->pkg_len[mid],
+                           pkg, pkg_len);
+        if(result <= 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    *po_end = lo;
+}
+
+static uint32_t version_lower_bound(const semver_index_t *p_index,
+                                    uint32_t first,
+                                    uint32_t end,
+                                    const semver_t *p_semver)
+{
+    uint64_t key_hi = KEY_HI(p_semver);
+    uint64_t key_lo = KEY_LO(p_semver);
+    uint32_t mid;
+
+    while(first < end)
+    {
+        mid = first + (end - first)/2;
+        if(row_cmp(p_index, mid, key_hi, key_lo, p_semver) < 0)
+        {
+            first = mid + 1;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+
+    return first;
+}
@@ -5,7 +5,7 @@
 #include <string.h>
 
 static int semver_str_validator(const char *semver_str,
-                                uint16_t semver_str_len,
+                                size_t semver_str_len,
                                 bool *po_has_primary,
                                 bool *po_has_pre_release,
                                 bool *po_has_bmd)
@@ -27,12 +27,19 @@ static int semver_str_validator(const char *semver_str,
 #define YYCURSOR    p
 #define YYLIMIT     (semver_str+semver_str_len)
 #define YYMARKER    q
-#define YYFILL(n)
+/* Bounds checked input: the end of the input reads as the terminating NUL
+ * the rules expect, so nothing past semver_str_len is ever read. */
+#define YYPEEK()    ((YYCURSOR < YYLIMIT)? *YYCURSOR : '\0')
+#define YYSKIP()    (YYCURSOR += (YYCURSOR < YYLIMIT))
+#define YYBACKUP()  (YYMARKER = YYCURSOR)
+#define YYRESTORE() (YYCURSOR = YYMARKER)
     
     for(;;)
     {
         /*!re2c
          re2c:indent:top = 2;
+         re2c:flags:input = custom;
+         re2c:yyfill:enable = 0;
          PRIMARY         = [0-9]+'.'[0-9]+'.'[0-9]+ ;
          PRE_RELEASE     = '-'([0-9A-Za-z-]+(('.'[0-9A-Za-z-]+)+)*) ;
          BUILD_META_DATA = '+'([0-9A-Za-z-]+(('.'[0-9A-Za-z-]+)+)*) ;
@@ -0,0 +1,218 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _semver_private_h_
+#define _semver_private_h_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "semver.h"
+
+/*!*****************************************************************************
+ * @file semver_private.h
+ *
+ * @brief Helpers shared between the modules of the library. Nothing in here
+ *        is part of the public interface.
+ *
+ ******************************************************************************/
+
+/******************************************************************************
+ * #defines
+ ******************************************************************************/
+/* The pre-release text of a semver, wherever it is stored. The build
+ * meta-data follows it, one byte past its end. */
+#define SEMVER_TAIL(p_semver) ((NULL != (p_semver)->tail)? \
+                               (p_semver)->tail : (p_semver)->inline_tail)
+
+/* States of the validator DFA that callers of semver_dfa_feed start from,
+ * or can give up in: no byte leads out of the dead state. */
+#define SEMVER_DFA_DEAD  0
+#define SEMVER_DFA_START 1
+
+/* Rows the columnar kernels compare per vector operation: one register's
+ * worth of 32-bit lanes. Without SIMD, GCC lowers the vector types to
+ * scalar code. */
+#if defined(__AVX2__)
+#define SEMVER_LANES 8
+#else
+#define SEMVER_LANES 4
+#endif
+
+/******************************************************************************
+ * type definitions /enums
+ ******************************************************************************/
+
+/* Columns of SEMVER_LANES rows, and per-lane masks (all ones or zero) as
+ * produced by comparing them. */
+typedef uint32_t semver_lanes_t __attribute__((vector_size(SEMVER_LANES * sizeof(uint32_t))));
+typedef int32_t semver_lane_mask_t __attribute__((vector_size(SEMVER_LANES * sizeof(int32_t))));
+typedef uint16_t semver_lanes16_t __attribute__((vector_size(SEMVER_LANES * sizeof(uint16_t))));
+typedef uint8_t semver_lanes8_t __attribute__((vector_size(SEMVER_LANES * sizeof(uint8_t))));
+
+/* The components of a version string, located but not copied. Offsets are
+ * relative to the start of the string; a length of 0 means "absent". */
+typedef struct semver_parts_
+{
+    uint32_t major;
+    uint32_t minor;
+    uint32_t patch;
+
+    uint16_t pr_off;
+    uint16_t pr_len;
+
+    uint16_t bmd_off;
+    uint16_t bmd_len;
+} semver_parts_t;
+
+/******************************************************************************
+ * function prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ *  @brief Validates a semver string and locates its components without
+ *         allocating. Safe to call concurrently.
+ *
+ *         Nothing past semver_str_len is read, so the string need not be
+ *         NUL terminated; it also ends at a NUL before semver_str_len.
+ *
+ *  @param semver_str     The semver string.
+ *  @param semver_str_len The length of the semver string.
+ *  @param po_parts       (OUTPARAM) The located components.
+ *
+ *  @return 0 if success, positive if invalid, negative if error
+ *****************************************************************************/
+int semver_parse_parts(const char* semver_str,
+                       size_t semver_str_len,
+                       semver_parts_t *po_parts);
+
+/******************************************************************************
+ *  @brief Validates a semver string with the table-driven DFA: a 256 entry
+ *         byte-class table feeding a 12 x 8 state-transition matrix.
+ *
+ *         Accepts exactly what the re2c validator accepts, with the same
+ *         conventions: at most semver_str_len bytes are read, and a NUL
+ *         ends the string. Parsing uses this engine instead of the re2c one
+ *         when built with -DSEMVER_TABLE_VALIDATOR.
+ *
+ *  @param semver_str         The semver string.
+ *  @param semver_str_len     The length of the semver string.
+ *  @param po_has_primary     (OUTPARAM, optional) Set if valid.
+ *  @param po_has_pre_release (OUTPARAM, optional) Set if there is a
+ *                            pre-release.
+ *  @param po_has_bmd         (OUTPARAM, optional) Set if there is build
+ *                            meta-data.
+ *
+ *  @return 0 if valid, positive if invalid, negative if error
+ *****************************************************************************/
+int semver_str_validator_table(const char* semver_str,
+                               size_t semver_str_len,
+                               bool *po_has_primary,
+                               bool *po_has_pre_release,
+                               bool *po_has_bmd);
+
+/******************************************************************************
+ *  @brief Finds the longest prefix of str the validator grammar accepts.
+ *
+ *         Only the grammar is checked; ranges and leading zeros are not.
+ *         The walk stops at the first byte no prefix could be extended
+ *         with, or at a NUL.
+ *
+ *  @param str The text.
+ *  @param len The length of the text.
+ *
+ *  @return The length of the prefix, 0 if there is none.
+ *****************************************************************************/
+size_t semver_longest_prefix(const char* str, size_t len);
+
+/******************************************************************************
+ *  @brief Advances the validator DFA over len more bytes of a string, so
+ *         that a string can be validated a piece at a time.
+ *
+ *  @param state The state after the previous piece, SEMVER_DFA_START for
+ *               the first one.
+ *  @param str   The next piece of the string.
+ *  @param len   The length of the piece.
+ *
+ *  @return The state after the piece.
+ *****************************************************************************/
+uint32_t semver_dfa_feed(uint32_t state, const char* str, size_t len);
+
+/******************************************************************************
+ *  @brief Determines whether a string the DFA is in state after would be
+ *         accepted if it ended there. Ranges and leading zeros are not
+ *         checked.
+ *****************************************************************************/
+bool semver_dfa_accepts(uint32_t state);
+
+/******************************************************************************
+ *  @brief The re2c-generated validator, under a name the table-driven one
+ *         can be compared against. Same conventions.
+ *****************************************************************************/
+int semver_str_validator_re2c(const char* semver_str,
+                              size_t semver_str_len,
+                              bool *po_has_primary,
+                              bool *po_has_pre_release,
+                              bool *po_has_bmd);
+
+/******************************************************************************
+ *  @brief Parses a run of decimal digits without leading zeros, 8 digits at
+ *         a time.
+ *
+ *  @param str      The digits; exactly len of them, no terminator needed.
+ *  @param len      The number of digits.
+ *  @param max      The largest acceptable value.
+ *  @param po_value (OUTPARAM) The value.
+ *
+ *  @return 0 if success, positive if not a canonical number or above max,
+ *          negative if error
+ *****************************************************************************/
+int semver_parse_uint(const char* str,
+                      size_t len,
+                      uint64_t max,
+                      uint64_t *po_value);
+
+/******************************************************************************
+ *  @brief Compares two pre-release identifiers by semver 2.0.0 precedence.
+ *
+ *  @return -1, 0 or 1 as id_a precedes, equals or follows id_b.
+ *****************************************************************************/
+int semver_identifier_cmp(const char* id_a, size_t len_a,
+                          const char* id_b, size_t len_b);
+
+/******************************************************************************
+ *  @brief Compares two dotted pre-release strings by semver 2.0.0
+ *         precedence. An empty string means "no pre-release", which follows
+ *         every pre-release.
+ *
+ *  @return -1, 0 or 1 as pr_a precedes, equals or follows pr_b.
+ *****************************************************************************/
+int semver_pr_str_cmp(const char* pr_a, size_t len_a,
+                      const char* pr_b, size_t len_b);
+
+/******************************************************************************
+ *  @brief Compares the pre-release of a semver against a dotted pre-release
+ *         string, with the same conventions as semver_pr_str_cmp.
+ *
+ *  @return -1, 0 or 1 as p_semver's pre-release precedes, equals or follows
+ *          pr_str.
+ *****************************************************************************/
+int semver_pr_cmp_str(const semver_t *p_semver,
+                      const char* pr_str, size_t pr_len);
+
+#endif /* _semver_private_h_ */
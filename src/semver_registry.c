@@ -0,0 +1,440 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "semver.h"
+#include "semver_registry.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Versions whose major, minor and patch are all below KEY_LIMIT pack into
+ * one 64-bit key: 21 bits each, then a "no pre-release" bit. The limit
+ * leaves the all-ones pattern free to mean "does not pack". */
+#define KEY_BITS  21
+#define KEY_LIMIT ((1u << KEY_BITS) - 1)
+#define NO_KEY    UINT64_MAX
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME        16777619u
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/* An immutable (key, version) pair. A package's latest version is swapped
+ * by swapping the record; the one it replaces hangs off p_prev until the
+ * registry is destroyed, since a reader may still be looking at it. */
+typedef struct registry_record_
+{
+    uint64_t key;
+    const semver_t *p_semver;
+    struct registry_record_ *p_prev;
+} registry_record_t;
+
+typedef struct registry_entry_
+{
+    //Never changes once the entry is reachable.
+    struct registry_entry_ *p_next;
+
+    _Atomic(registry_record_t*) p_latest;
+    uint32_t hash;
+    size_t name_len;
+    char name[];
+} registry_entry_t;
+
+struct semver_registry_
+{
+    _Atomic(registry_entry_t*) *buckets;
+    uint32_t bucket_mask;
+};
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static uint32_t hash_bytes(const char* str, size_t len);
+static uint64_t pack_key(const semver_t *p_semver);
+static int version_cmp(uint64_t key_a, const semver_t *p_a,
+                       uint64_t key_b, const semver_t *p_b);
+static registry_record_t* record_create(const semver_t *p_semver, uint64_t key);
+static void record_destroy(registry_record_t *p_record);
+static registry_entry_t* find_entry(registry_entry_t *p_entry,
+                                    uint32_t hash,
+                                    const char* name,
+                                    size_t name_len);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_registry_create(semver_registry_t **p2o_registry, uint32_t capacity)
+{
+    semver_registry_t *p_registry;
+    uint32_t num_buckets;
+    uint32_t i;
+
+    if(NULL == p2o_registry || 0 == capacity)
+    {
+        return 1;
+    }
+
+    p_registry = (semver_registry_t*)malloc(sizeof(semver_registry_t));
+    if(NULL == p_registry)
+    {
+        return 1;
+    }
+
+    //Keep chains short: at least two buckets per package, power of two.
+    num_buckets = 1;
+    while(num_buckets < 2*capacity && num_buckets < (1u << 31))
+    {
+        num_buckets <<= 1;
+    }
+
+    p_registry->bucket_mask = num_buckets - 1;
+    p_registry->buckets = malloc(num_buckets * sizeof(p_registry->buckets[0]));
+    if(NULL == p_registry->buckets)
+    {
+        free(p_registry);
+        return 1;
+    }
+
+    for(i=0;i<num_buckets;i++)
+    {
+        atomic_init(&p_registry->buckets[i], NULL);
+    }
+
+    *p2o_registry = p_registry;
+    return 0;
+}
+
+int semver_registry_destroy(semver_registry_t *po_registry)
+{
+    registry_entry_t *p_entry;
+    registry_entry_t *p_next;
+    registry_record_t *p_record;
+    registry_record_t *p_prev;
+    uint32_t i;
+
+    if(NULL == po_registry)
+    {
+        return 1;
+    }
+
+    for(i=0;i<=po_registry->bucket_mask;i++)
+    {
+        p_entry = atomic_load_explicit(&po_registry->buckets[i], memory_order_acquire);
+        while(NULL != p_entry)
+        {
+            p_next = p_entry->p_next;
+
+            p_record = atomic_load_explicit(&p_entry->p_latest, memory_order_acquire);
+            while(NULL != p_record)
+            {
+                p_prev = p_record->p_prev;
+                record_destroy(p_record);
+                p_record = p_prev;
+            }
+
+            free(p_entry);
+            p_entry = p_next;
+        }
+    }
+
+    free(po_registry->buckets);
+    free(po_registry);
+    return 0;
+}
+
+int semver_registry_report(semver_registry_t *p_registry,
+                           const char* package,
+                           size_t package_len,
+                           const semver_t *p_semver)
+{
+    _Atomic(registry_entry_t*) *p_bucket;
+    registry_entry_t *p_head;
+    registry_entry_t *p_entry;
+    registry_entry_t *p_new_entry;
+    registry_record_t *p_record;
+    registry_record_t *p_new = NULL;
+    uint64_t key;
+    uint32_t hash;
+
+    if(NULL == p_registry || NULL == package || NULL == p_semver)
+    {
+        return -1;
+    }
+
+    key = pack_key(p_semver);
+    hash = hash_bytes(package, package_len);
+    p_bucket = &p_registry->buckets[hash & p_registry->bucket_mask];
+
+    p_head = atomic_load_explicit(p_bucket, memory_order_acquire);
+    p_entry = find_entry(p_head, hash, package, package_len);
+
+    if(NULL == p_entry)
+    {
+        p_new = record_create(p_semver, key);
+        p_new_entry = (registry_entry_t*)malloc(sizeof(registry_entry_t) + package_len);
+        if(NULL == p_new || NULL == p_new_entry)
+        {
+            record_destroy(p_new);
+            free(p_new_entry);
+            return -1;
+        }
+
+        atomic_init(&p_new_entry->p_latest, p_new);
+        p_new_entry->hash = hash;
+        p_new_entry->name_len = package_len;
+        memcpy(p_new_entry->name, package, package_len);
+
+        //Entries are only ever pushed on the front of a chain, so after a
+        //lost race only the entries in front of the old head are new.
+        for(;;)
+        {
+            p_new_entry->p_next = p_head;
+            if(atomic_compare_exchange_weak_explicit(p_bucket, &p_head, p_new_entry,
+                                                     memory_order_release,
+                                                     memory_order_acquire))
+            {
+                return 0;
+            }
+
+            p_entry = find_entry(p_head, hash, package, package_len);
+            if(NULL != p_entry)
+            {
+                break;
+            }
+        }
+
+        //Somebody else added the package first; report to theirs.
+        free(p_new_entry);
+    }
+
+    p_record = atomic_load_explicit(&p_entry->p_latest, memory_order_acquire);
+    for(;;)
+    {
+        if(version_cmp(key, p_semver, p_record->key, p_record->p_semver) <= 0)
+        {
+            record_destroy(p_new);
+            return 1;
+        }
+
+        //Only a version that is actually newer costs a copy.
+        if(NULL == p_new)
+        {
+            p_new = record_create(p_semver, key);
+            if(NULL == p_new)
+            {
+                return -1;
+            }
+        }
+
+        p_new->p_prev = p_record;
+        if(atomic_compare_exchange_weak_explicit(&p_entry->p_latest, &p_record, p_new,
+                                                 memory_order_release,
+                                                 memory_order_acquire))
+        {
+            return 0;
+        }
+    }
+}
+
+int semver_registry_latest(semver_registry_t *p_registry,
+                           const char* package,
+                           size_t package_len,
+                           const semver_t **p2o_latest)
+{
+    registry_entry_t *p_entry;
+    uint32_t hash;
+
+    if(NULL == p_registry || NULL == package || NULL == p2o_latest)
+    {
+        return -1;
+    }
+
+    hash = hash_bytes(package, package_len);
+    p_entry = find_entry(atomic_load_explicit(&p_registry->buckets[hash & p_registry->bucket_mask],
+                                              memory_order_acquire),
+                         hash, package, package_len);
+    if(NULL == p_entry)
+    {
+        return 1;
+    }
+
+    *p2o_latest = atomic_load_explicit(&p_entry->p_latest, memory_order_acquire)->p_semver;
+    return 0;
+}
+
+int semver_registry_snapshot(semver_registry_t *p_registry,
+                             semver_registry_entry_t **p2o_entries,
+                             size_t *po_num_entries)
+{
+    semver_registry_entry_t *p_entries = NULL;
+    semver_registry_entry_t *p_grown;
+    registry_entry_t *p_entry;
+    size_t num_entries = 0;
+    size_t capacity = 0;
+    uint32_t i;
+
+    if(NULL == p_registry || NULL == p2o_entries || NULL == po_num_entries)
+    {
+        return 1;
+    }
+
+    for(i=0;i<=p_registry->bucket_mask;i++)
+    {
+        p_entry = atomic_load_explicit(&p_registry->buckets[i], memory_order_acquire);
+        for(;NULL != p_entry;p_entry = p_entry->p_next)
+        {
+            if(num_entries == capacity)
+            {
+                capacity = (0 == capacity)? 64 : 2*capacity;
+                p_grown = (semver_registry_entry_t*)realloc(p_entries,
+                                                            capacity * sizeof(semver_registry_entry_t));
+                if(NULL == p_grown)
+                {
+                    free(p_entries);
+                    return 1;
+                }
+                p_entries = p_grown;
+            }
+
+            p_entries[num_entries].package = p_entry->name;
+            p_entries[num_entries].package_len = p_entry->name_len;
+            p_entries[num_entries].p_latest =
+                atomic_load_explicit(&p_entry->p_latest, memory_order_acquire)->p_semver;
+            num_entries++;
+        }
+    }
+
+    *p2o_entries = p_entries;
+    *po_num_entries = num_entries;
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+//FNV-1a; package names are short, so this beats anything fancier.
+static uint32_t hash_bytes(const char* str, size_t len)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    size_t i;
+
+    for(i=0;i<len;i++)
+    {
+        hash ^= (uint8_t)str[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static uint64_t pack_key(const semver_t *p_semver)
+{
+    if(p_semver->major >= KEY_LIMIT ||
+       p_semver->minor >= KEY_LIMIT ||
+       p_semver->patch >= KEY_LIMIT)
+    {
+        return NO_KEY;
+    }
+
+    return ((uint64_t)p_semver->major << (2*KEY_BITS + 1)) |
+           ((uint64_t)p_semver->minor << (KEY_BITS + 1)) |
+           ((uint64_t)p_semver->patch << 1) |
+           (0 == p_semver->pr_len);
+}
+
+//Two packed keys settle everything but pre-releases of the same version;
+//a version too large to pack is compared in full.
+static int version_cmp(uint64_t key_a, const semver_t *p_a,
+                       uint64_t key_b, const semver_t *p_b)
+{
+    int cmp = 0;
+
+    if(NO_KEY != key_a && NO_KEY != key_b)
+    {
+        if(key_a != key_b)
+        {
+            return (key_a < key_b)? -1 : 1;
+        }
+
+        if(0 != (key_a & 1))
+        {
+            return 0;
+        }
+
+        return semver_pr_str_cmp(SEMVER_TAIL(p_a), p_a->pr_len,
+                                 SEMVER_TAIL(p_b), p_b->pr_len);
+    }
+
+    semver_compare(p_a, p_b, &cmp);
+    return cmp;
+}
+
+static registry_record_t* record_create(const semver_t *p_semver, uint64_t key)
+{
+    registry_record_t *p_record;
+
+    p_record = (registry_record_t*)malloc(sizeof(registry_record_t));
+    if(NULL == p_record)
+    {
+        return NULL;
+    }
+
+    if(0 != semver_freeze(p_semver, &p_record->p_semver))
+    {
+        free(p_record);
+        return NULL;
+    }
+
+    p_record->key = key;
+    p_record->p_prev = NULL;
+    return p_record;
+}
+
+static void record_destroy(registry_record_t *p_record)
+{
+    if(NULL != p_record)
+    {
+        semver_unref(p_record->p_semver);
+        free(p_record);
+    }
+}
+
+static registry_entry_t* find_entry(registry_entry_t *p_entry,
+                                    uint32_t hash,
+                                    const char* name,
+                                    size_t name_len)
+{
+    while(NULL != p_entry)
+    {
+        if(p_entry->hash == hash &&
+           p_entry->name_len == name_len &&
+           0 == memcmp(p_entry->name, name, name_len))
+        {
+            return p_entry;
+        }
+        p_entry = p_entry->p_next;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,664 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "semver.h"
+#include "semver_batch.h"
+#include "semver_select.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/* Orders heap items: negative if item a ranks below item b. Must be a
+ * total order, ties in precedence broken by arrival. */
+typedef int (*item_cmp_t)(const void *p_ctx, size_t a, size_t b);
+
+typedef struct batch_ctx_
+{
+    const semver_batch_t *p_batch;
+    const char* buf;
+} batch_ctx_t;
+
+/* The version core of a row, with the release flag as a fourth component:
+ * a release follows every pre-release of its version. */
+typedef struct core_
+{
+    uint32_t major;
+    uint32_t minor;
+    uint32_t patch;
+    uint32_t release;
+    size_t row;
+} core_t;
+
+/* One lane-wise candidate per vector lane. */
+typedef struct core_lanes_
+{
+    semver_lanes_t major;
+    semver_lanes_t minor;
+    semver_lanes_t patch;
+    semver_lanes_t release;
+    semver_lanes_t row;
+} core_lanes_t;
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static int semver_rank_cmp(const semver_t *p_a, const semver_t *p_b);
+static int array_item_cmp(const void *p_ctx, size_t a, size_t b);
+static int batch_row_cmp(const batch_ctx_t *p_ctx, size_t a, size_t b);
+static int batch_item_cmp(const void *p_ctx, size_t a, size_t b);
+static int stream_item_cmp(const void *p_ctx, size_t a, size_t b);
+static void heap_sift_down(size_t *heap, size_t num, size_t pos,
+                           item_cmp_t cmp, const void *p_ctx);
+static void heap_sift_up(size_t *heap, size_t pos,
+                         item_cmp_t cmp, const void *p_ctx);
+static void heap_sort_desc(size_t *heap, size_t num,
+                           item_cmp_t cmp, const void *p_ctx);
+static int array_extreme(const semver_t *p_semvers, size_t num, int sign, size_t *po_index);
+static int batch_extreme(const semver_batch_t *p_batch, const char* buf, int sign, size_t *po_row);
+static void lane_select(core_lanes_t *p_best,
+                        semver_lane_mask_t *p_has,
+                        const core_lanes_t *p_curr,
+                        semver_lane_mask_t valid,
+                        int sign);
+static int core_cmp(const core_t *p_a, const core_t *p_b);
+static void row_core(const semver_batch_t *p_batch, size_t row, core_t *po_core);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_max(const semver_t *p_semvers, size_t num, size_t *po_index)
+{
+    return array_extreme(p_semvers, num, 1, po_index);
+}
+
+int semver_min(const semver_t *p_semvers, size_t num, size_t *po_index)
+{
+    return array_extreme(p_semvers, num, -1, po_index);
+}
+
+int semver_top_k(const semver_t *p_semvers,
+                 size_t num,
+                 size_t k,
+                 size_t *po_indices,
+                 size_t *po_num)
+{
+    size_t num_kept = 0;
+    size_t i;
+
+    if((NULL == p_semvers && 0 != num) || (NULL == po_indices && 0 != k) || NULL == po_num)
+    {
+        return 1;
+    }
+
+    //The k newest so far, the lowest ranked on top; a version that does
+    //not beat it is dropped after one comparison.
+    for(i=0;i<num && 0 != k;i++)
+    {
+        if(num_kept < k)
+        {
+            po_indices[num_kept] = i;
+            heap_sift_up(po_indices, num_kept++, array_item_cmp, p_semvers);
+        }
+        else if(array_item_cmp(p_semvers, i, po_indices[0]) > 0)
+        {
+            po_indices[0] = i;
+            heap_sift_down(po_indices, num_kept, 0, array_item_cmp, p_semvers);
+        }
+    }
+
+    heap_sort_desc(po_indices, num_kept, array_item_cmp, p_semvers);
+    *po_num = num_kept;
+    return 0;
+}
+
+int semver_batch_max(const semver_batch_t *p_batch, const char* buf, size_t *po_row)
+{
+    return batch_extreme(p_batch, buf, 1, po_row);
+}
+
+int semver_batch_min(const semver_batch_t *p_batch, const char* buf, size_t *po_row)
+{
+    return batch_extreme(p_batch, buf, -1, po_row);
+}
+
+int semver_batch_top_k(const semver_batch_t *p_batch,
+                       const char* buf,
+                       size_t k,
+                       size_t *po_rows,
+                       size_t *po_num)
+{
+    batch_ctx_t ctx;
+    size_t num_kept = 0;
+    size_t row;
+
+    if(NULL == p_batch || NULL == buf || (NULL == po_rows && 0 != k) || NULL == po_num)
+    {
+        return 1;
+    }
+
+    ctx.p_batch = p_batch;
+    ctx.buf = buf;
+
+    for(row=0;row<p_batch->count && 0 != k;row++)
+    {
+        if(0 != p_batch->status[row])
+        {
+            continue;
+        }
+
+        if(num_kept < k)
+        {
+            po_rows[num_kept] = row;
+            heap_sift_up(po_rows, num_kept++, batch_item_cmp, &ctx);
+        }
+        else if(batch_item_cmp(&ctx, row, po_rows[0]) > 0)
+        {
+            po_rows[0] = row;
+            heap_sift_down(po_rows, num_kept, 0, batch_item_cmp, &ctx);
+        }
+    }
+
+    heap_sort_desc(po_rows, num_kept, batch_item_cmp, &ctx);
+    *po_num = num_kept;
+    return 0;
+}
+
+int semver_top_k_init(semver_top_k_t *po_top_k, size_t k)
+{
+    if(NULL == po_top_k || 0 == k)
+    {
+        return 1;
+    }
+
+    memset(po_top_k, 0, sizeof(semver_top_k_t));
+    po_top_k->k = k;
+    po_top_k->slots = (const semver_t**)calloc(k, sizeof(semver_t*));
+    po_top_k->seqs = (uint64_t*)malloc(k * sizeof(uint64_t));
+    po_top_k->heap = (size_t*)malloc(k * sizeof(size_t));
+    po_top_k->scratch = (size_t*)malloc(k * sizeof(size_t));
+
+    if(NULL == po_top_k->slots || NULL == po_top_k->seqs ||
+       NULL == po_top_k->heap || NULL == po_top_k->scratch)
+    {
+        semver_top_k_fini(po_top_k);
+        return 1;
+    }
+
+    return 0;
+}
+
+int semver_top_k_fini(semver_top_k_t *po_top_k)
+{
+    size_t i;
+
+    if(NULL == po_top_k)
+    {
+        return 1;
+    }
+
+    for(i=0;i<po_top_k->num;i++)
+    {
+        semver_unref(po_top_k->slots[i]);
+    }
+
+    free(po_top_k->slots);
+    free(po_top_k->seqs);
+    free(po_top_k->heap);
+    free(po_top_k->scratch);
+    memset(po_top_k, 0, sizeof(semver_top_k_t));
+
+    return 0;
+}
+
+int semver_top_k_push(semver_top_k_t *p_top_k, const semver_t *p_semver)
+{
+    const semver_t *p_frozen;
+    size_t slot;
+
+    if(NULL == p_top_k || NULL == p_semver || 0 == p_top_k->k)
+    {
+        return -1;
+    }
+
+    //Later arrivals lose ties, so a full selection only takes a version
+    //that strictly outranks its lowest one.
+    if(p_top_k->num == p_top_k->k &&
+       semver_rank_cmp(p_semver, p_top_k->slots[p_top_k->heap[0]]) <= 0)
+    {
+        p_top_k->next_seq++;
+        return 1;
+    }
+
+    if(0 != semver_freeze(p_semver, &p_frozen))
+    {
+        return -1;
+    }
+
+    if(p_top_k->num < p_top_k->k)
+    {
+        slot = p_top_k->num;
+        p_top_k->slots[slot] = p_frozen;
+        p_top_k->seqs[slot] = p_top_k->next_seq++;
+        p_top_k->heap[slot] = slot;
+        heap_sift_up(p_top_k->heap, p_top_k->num++, stream_item_cmp, p_top_k);
+    }
+    else
+    {
+        slot = p_top_k->heap[0];
+        semver_unref(p_top_k->slots[slot]);
+        p_top_k->slots[slot] = p_frozen;
+        p_top_k->seqs[slot] = p_top_k->next_seq++;
+        heap_sift_down(p_top_k->heap, p_top_k->num, 0, stream_item_cmp, p_top_k);
+    }
+
+    return 0;
+}
+
+int semver_top_k_result(semver_top_k_t *p_top_k,
+                        const semver_t **po_semvers,
+                        size_t *po_num)
+{
+    size_t i;
+
+    if(NULL == p_top_k || NULL == po_semvers || NULL == po_num)
+    {
+        return 1;
+    }
+
+    //Sort a copy, so that the heap stays intact for further pushes.
+    memcpy(p_top_k->scratch, p_top_k->heap, p_top_k->num * sizeof(size_t));
+    heap_sort_desc(p_top_k->scratch, p_top_k->num, stream_item_cmp, p_top_k);
+
+    for(i=0;i<p_top_k->num;i++)
+    {
+        po_semvers[i] = p_top_k->slots[p_top_k->scratch[i]];
+    }
+
+    *po_num = p_top_k->num;
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+//Precedence, with the pre-release text only compared on a numeric tie.
+static int semver_rank_cmp(const semver_t *p_a, const semver_t *p_b)
+{
+    if(p_a->major != p_b->major)
+    {
+        return (p_a->major < p_b->major)? -1 : 1;
+    }
+    if(p_a->minor != p_b->minor)
+    {
+        return (p_a->minor < p_b->minor)? -1 : 1;
+    }
+    if(p_a->patch != p_b->patch)
+    {
+        return (p_a->patch < p_b->patch)? -1 : 1;
+    }
+    if(0 == p_a->pr_len && 0 == p_b->pr_len)
+    {
+        return 0;
+    }
+
+    return semver_pr_str_cmp(SEMVER_TAIL(p_a), p_a->pr_len, SEMVER_TAIL(p_b), p_b->pr_len);
+}
+
+static int array_item_cmp(const void *p_ctx, size_t a, size_t b)
+{
+    const semver_t *p_semvers = (const semver_t*)p_ctx;
+    int cmp = semver_rank_cmp(&p_semvers[a], &p_semvers[b]);
+
+    if(0 != cmp || a == b)
+    {
+        return cmp;
+    }
+
+    //The earlier of two equals ranks higher.
+    return (a < b)? 1 : -1;
+}
+
+static int batch_row_cmp(const batch_ctx_t *p_ctx, size_t a, size_t b)
+{
+    const semver_batch_t *p_batch = p_ctx->p_batch;
+
+    if(p_batch->major[a] != p_batch->major[b])
+    {
+        return (p_batch->major[a] < p_batch->major[b])? -1 : 1;
+    }
+    if(p_batch->minor[a] != p_batch->minor[b])
+    {
+        return (p_batch->minor[a] < p_batch->minor[b])? -1 : 1;
+    }
+    if(p_batch->patch[a] != p_batch->patch[b])
+    {
+        return (p_batch->patch[a] < p_batch->patch[b])? -1 : 1;
+    }
+    if(0 == p_batch->pr_len[a] && 0 == p_batch->pr_len[b])
+    {
+        return 0;
+    }
+
+    return semver_pr_str_cmp(p_ctx->buf + p_batch->line_off[a] + p_batch->pr_off[a],
+                             p_batch->pr_len[a],
+                             p_ctx->buf + p_batch->line_off[b] + p_batch->pr_off[b],
+                             p_batch->pr_len[b]);
+}
+
+static int batch_item_cmp(const void *p_ctx, size_t a, size_t b)
+{
+    int cmp = batch_row_cmp((const batch_ctx_t*)p_ctx, a, b);
+
+    if(0 != cmp || a == b)
+    {
+        return cmp;
+    }
+
+    return (a < b)? 1 : -1;
+}
+
+static int stream_item_cmp(const void *p_ctx, size_t a, size_t b)
+{
+    const semver_top_k_t *p_top_k = (const semver_top_k_t*)p_ctx;
+    int cmp = semver_rank_cmp(p_top_k->slots[a], p_top_k->slots[b]);
+
+    if(0 != cmp || a == b)
+    {
+        return cmp;
+    }
+
+    return (p_top_k->seqs[a] < p_top_k->seqs[b])? 1 : -1;
+}
+
+static void heap_sift_down(size_t *heap, size_t num, size_t pos,
+                           item_cmp_t cmp, const void *p_ctx)
+{
+    size_t item = heap[pos];
+    size_t child;
+
+    for(;;)
+    {
+        child = 2*pos + 1;
+        if(child >= num)
+        {
+            break;
+        }
+        if(child + 1 < num && cmp(p_ctx, heap[child + 1], heap[child]) < 0)
+        {
+            child++;
+        }
+        if(cmp(p_ctx, heap[child], item) >= 0)
+        {
+            break;
+        }
+
+        heap[pos] = heap[child];
+        pos = child;
+    }
+
+    heap[pos] = item;
+}
+
+static void heap_sift_up(size_t *heap, size_t pos,
+                         item_cmp_t cmp, const void *p_ctx)
+{
+    size_t item = heap[pos];
+    size_t parent;
+
+    while(pos > 0)
+    {
+        parent = (pos - 1) / 2;
+        if(cmp(p_ctx, heap[parent], item) <= 0)
+        {
+            break;
+        }
+
+        heap[pos] = heap[parent];
+        pos = parent;
+    }
+
+    heap[pos] = item;
+}
+
+//Repeatedly moves the lowest ranked item to the back, which leaves a
+//min-heap sorted highest ranked first.
+static void heap_sort_desc(size_t *heap, size_t num,
+                           item_cmp_t cmp, const void *p_ctx)
+{
+    size_t item;
+
+    while(num > 1)
+    {
+        num--;
+        item = heap[0];
+        heap[0] = heap[num];
+        heap[num] = item;
+        heap_sift_down(heap, num, 0, cmp, p_ctx);
+    }
+}
+
+//sign is 1 for the maximum, -1 for the minimum.
+static int array_extreme(const semver_t *p_semvers, size_t num, int sign, size_t *po_index)
+{
+    size_t best = 0;
+    size_t i;
+
+    if(NULL == p_semvers || NULL == po_index)
+    {
+        return -1;
+    }
+
+    if(0 == num)
+    {
+        return 1;
+    }
+
+    for(i=1;i<num;i++)
+    {
+        if(sign * semver_rank_cmp(&p_semvers[i], &p_semvers[best]) > 0)
+        {
+            best = i;
+        }
+    }
+
+    *po_index = best;
+    return 0;
+}
+
+//Each vector lane keeps the best core among the rows it has seen, first
+//come on ties. The lanes are then reduced, the rows that do not fill a
+//vector checked one by one, and, if the winning core is a pre-release, the
+//rows sharing it compared by pre-release text.
+static int batch_extreme(const semver_batch_t *p_batch, const char* buf, int sign, size_t *po_row)
+{
+    batch_ctx_t ctx;
+    core_lanes_t best;
+    core_lanes_t curr;
+    semver_lane_mask_t has = { 0 };
+    core_t winner;
+    core_t cand;
+    bool found = false;
+    size_t num_blocks;
+    size_t row;
+    int lane;
+
+    if(NULL == p_batch || NULL == buf || NULL == po_row)
+    {
+        return -1;
+    }
+
+    memset(&best, 0, sizeof(best));
+    for(lane=0;lane<SEMVER_LANES;lane++)
+    {
+        curr.row[lane] = lane;
+    }
+
+    //Row numbers live in 32-bit lanes; batches too large for them are
+    //scanned one row at a time.
+    num_blocks = (p_batch->count <= UINT32_MAX)? p_batch->count / SEMVER_LANES : 0;
+
+    for(row=0;row<num_blocks*SEMVER_LANES;row+=SEMVER_LANES)
+    {
+        semver_lanes16_t pr_len;
+        semver_lanes8_t status;
+        semver_lane_mask_t valid;
+
+        memcpy(&curr.major, &p_batch->major[row], sizeof(curr.major));
+        memcpy(&curr.minor, &p_batch->minor[row], sizeof(curr.minor));
+        memcpy(&curr.patch, &p_batch->patch[row], sizeof(curr.patch));
+        memcpy(&pr_len, &p_batch->pr_len[row], sizeof(pr_len));
+        memcpy(&status, &p_batch->status[row], sizeof(status));
+
+        curr.release = (semver_lanes_t)(__builtin_convertvector(pr_len, semver_lanes_t) == 0) & 1;
+        valid = (__builtin_convertvector(status, semver_lanes_t) == 0);
+
+        lane_select(&best, &has, &curr, valid, sign);
+        curr.row += SEMVER_LANES;
+    }
+
+    for(lane=0;lane<SEMVER_LANES;lane++)
+    {
+        if(0 == has[lane])
+        {
+            continue;
+        }
+
+        cand.major = best.major[lane];
+        cand.minor = best.minor[lane];
+        cand.patch = best.patch[lane];
+        cand.release = best.release[lane];
+        cand.row = best.row[lane];
+
+        if(!found || sign * core_cmp(&cand, &winner) > 0 ||
+           (0 == core_cmp(&cand, &winner) && cand.row < winner.row))
+        {
+            winner = cand;
+            found = true;
+        }
+    }
+
+    for(row=num_blocks*SEMVER_LANES;row<p_batch->count;row++)
+    {
+        if(0 != p_batch->status[row])
+        {
+            continue;
+        }
+
+        row_core(p_batch, row, &cand);
+        if(!found || sign * core_cmp(&cand, &winner) > 0)
+        {
+            winner = cand;
+            found = true;
+        }
+    }
+
+    if(!found)
+    {
+        return 1;
+    }
+
+    //winner.row is the first row with the winning core; only pre-releases
+    //of it can still differ.
+    if(0 == winner.release)
+    {
+        ctx.p_batch = p_batch;
+        ctx.buf = buf;
+
+        for(row=winner.row+1;row<p_batch->count;row++)
+        {
+            if(0 == p_batch->status[row] &&
+               p_batch->major[row] == winner.major &&
+               p_batch->minor[row] == winner.minor &&
+               p_batch->patch[row] == winner.patch &&
+               0 != p_batch->pr_len[row] &&
+               sign * batch_row_cmp(&ctx, row, winner.row) > 0)
+            {
+                winner.row = row;
+            }
+        }
+    }
+
+    *po_row = winner.row;
+    return 0;
+}
+
+//Takes the lanes of p_curr which are valid and strictly better than the
+//lane's best so far, or the first valid ones the lane sees.
+static void lane_select(core_lanes_t *p_best,
+                        semver_lane_mask_t *p_has,
+                        const core_lanes_t *p_curr,
+                        semver_lane_mask_t valid,
+                        int sign)
+{
+    const core_lanes_t *p_hi = (sign > 0)? p_curr : p_best;
+    const core_lanes_t *p_lo = (sign > 0)? p_best : p_curr;
+    semver_lane_mask_t better;
+    semver_lanes_t take;
+
+    better = (p_hi->major > p_lo->major) |
+             ((p_hi->major == p_lo->major) &
+              ((p_hi->minor > p_lo->minor) |
+               ((p_hi->minor == p_lo->minor) &
+                ((p_hi->patch > p_lo->patch) |
+                 ((p_hi->patch == p_lo->patch) & (p_hi->release > p_lo->release))))));
+
+    take = (semver_lanes_t)(valid & (~*p_has | better));
+
+    p_best->major = (p_curr->major & take) | (p_best->major & ~take);
+    p_best->minor = (p_curr->minor & take) | (p_best->minor & ~take);
+    p_best->patch = (p_curr->patch & take) | (p_best->patch & ~take);
+    p_best->release = (p_curr->release & take) | (p_best->release & ~take);
+    p_best->row = (p_curr->row & take) | (p_best->row & ~take);
+    *p_has |= valid;
+}
+
+static int core_cmp(const core_t *p_a, const core_t *p_b)
+{
+    if(p_a->major != p_b->major)
+    {
+        return (p_a->major < p_b->major)? -1 : 1;
+    }
+    if(p_a->minor != p_b->minor)
+    {
+        return (p_a->minor < p_b->minor)? -1 : 1;
+    }
+    if(p_a->patch != p_b->patch)
+    {
+        return (p_a->patch < p_b->patch)? -1 : 1;
+    }
+    if(p_a->release != p_b->release)
+    {
+        return (p_a->release < p_b->release)? -1 : 1;
+    }
+
+    return 0;
+}
+
+static void row_core(const semver_batch_t *p_batch, size_t row, core_t *po_core)
+{
+    po_core->major = p_batch->major[row];
+    po_core->minor = p_batch->minor[row];
+    po_core->patch = p_batch->patch[row];
+    po_core->release = (0 == p_batch->pr_len[row]);
+    po_core->row = row;
+}
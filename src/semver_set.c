@@ -0,0 +1,492 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "semver.h"
+#include "semver_set.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* Enough levels for hundreds of millions of versions at p = 1/2. */
+#define MAX_HEIGHT 28
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME        16777619u
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/* Precedence packed into two words, so that most comparisons are two
+ * integer compares: major and minor in hi, patch and a "no pre-release"
+ * bit in lo. Only equal words with a pre-release on both sides need to look
+ * at the pre-release text. */
+typedef struct set_key_
+{
+    uint64_t hi;
+    uint64_t lo;
+    const char* pr;
+    uint16_t pr_len;
+} set_key_t;
+
+typedef struct set_node_
+{
+    set_key_t key;
+    const semver_t *p_semver;
+    _Atomic(struct set_node_*) next[];
+} set_node_t;
+
+struct semver_set_
+{
+    set_node_t *p_head;
+
+    //Levels in use. Only a hint for where searches start: every level of
+    //the head exists, empty or not.
+    atomic_uint height;
+    atomic_size_t size;
+};
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void make_key(const semver_t *p_semver, set_key_t *po_key);
+static int key_cmp(const set_key_t *p_a, const set_key_t *p_b);
+static uint32_t key_height(const set_key_t *p_key);
+static set_node_t* node_create(uint32_t height);
+static void search(semver_set_t *p_set,
+                   const set_key_t *p_key,
+                   set_node_t **po_preds,
+                   set_node_t **po_succs);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_set_create(semver_set_t **p2o_set)
+{
+    semver_set_t *p_set;
+
+    if(NULL == p2o_set)
+    {
+        return 1;
+    }
+
+    p_set = (semver_set_t*)malloc(sizeof(semver_set_t));
+    if(NULL == p_set)
+    {
+        return 1;
+    }
+
+    p_set->p_head = node_create(MAX_HEIGHT);
+    if(NULL == p_set->p_head)
+    {
+        free(p_set);
+        return 1;
+    }
+
+    atomic_init(&p_set->height, 1);
+    atomic_init(&p_set->size, 0);
+
+    *p2o_set = p_set;
+    return 0;
+}
+
+int semver_set_destroy(semver_set_t *po_set)
+{
+    set_node_t *p_node;
+    set_node_t *p_next;
+
+    if(NULL == po_set)
+    {
+        return 1;
+    }
+
+    p_node = atomic_load_explicit(&po_set->p_head->next[0], memory_order_acquire);
+    while(NULL != p_node)
+    {
+        p_next = atomic_load_explicit(&p_node->next[0], memory_order_acquire);
+        semver_unref(p_node->p_semver);
+        free(p_node);
+        p_node = p_next;
+    }
+
+    free(po_set->p_head);
+    free(po_set);
+    return 0;
+}
+
+int semver_set_insert(semver_set_t *p_set, const semver_t *p_semver)
+{
+    set_node_t *preds[MAX_HEIGHT];
+    set_node_t *succs[MAX_HEIGHT];
+    set_node_t *p_node;
+    set_node_t *p_expected;
+    set_key_t key;
+    uint32_t height;
+    uint32_t top;
+    uint32_t level;
+    uint32_t l;
+
+    if(NULL == p_set || NULL == p_semver)
+    {
+        return -1;
+    }
+
+    make_key(p_semver, &key);
+
+    search(p_set, &key, preds, succs);
+    if(NULL != succs[0] && 0 == key_cmp(&succs[0]->key, &key))
+    {
+        return 1;
+    }
+
+    height = key_height(&key);
+    p_node = node_create(height);
+    if(NULL == p_node)
+    {
+        return -1;
+    }
+
+    if(0 != semver_freeze(p_semver, &p_node->p_semver))
+    {
+        free(p_node);
+        return -1;
+    }
+    make_key(p_node->p_semver, &p_node->key);
+
+    //Raise the height first, so searches from here on walk every level the
+    //node will be linked on; one that started lower only misses a
+    //shortcut. The node's own links are kept current further down.
+    top = atomic_load_explicit(&p_set->height, memory_order_relaxed);
+    while(top < height &&
+          !atomic_compare_exchange_weak_explicit(&p_set->height, &top, height,
+                                                 memory_order_relaxed,
+                                                 memory_order_relaxed))
+    {
+    }
+
+    //Linking at the bottom level is what puts the node in the set. Losing
+    //the race to an equal version means it is already present.
+    for(;;)
+    {
+        for(level=0;level<height;level++)
+        {
+            atomic_store_explicit(&p_node->next[level], succs[level], memory_order_relaxed);
+        }
+
+        p_expected = succs[0];
+        if(atomic_compare_exchange_strong_explicit(&preds[0]->next[0], &p_expected, p_node,
+                                                   memory_order_release,
+                                                   memory_order_relaxed))
+        {
+            break;
+        }
+
+        search(p_set, &key, preds, succs);
+        if(NULL != succs[0] && 0 == key_cmp(&succs[0]->key, &key))
+        {
+            semver_unref(p_node->p_semver);
+            free(p_node);
+            return 1;
+        }
+    }
+
+    atomic_fetch_add_explicit(&p_set->size, 1, memory_order_relaxed);
+
+    //The upper levels are shortcuts; link them one at a time, bottom up,
+    //searching again whenever another insert got in between.
+    for(level=1;level<height;level++)
+    {
+        for(;;)
+        {
+            p_expected = succs[level];
+            if(atomic_compare_exchange_strong_explicit(&preds[level]->next[level], &p_expected,
+                                                       p_node,
+                                                       memory_order_release,
+                                                       memory_order_relaxed))
+            {
+                break;
+            }
+
+            //The search refreshes every level, and the levels still to be
+            //linked must point at the new successors too: one left stale
+            //would cut out whatever was linked in between at that level.
+            search(p_set, &key, preds, succs);
+            for(l=level;l<height;l++)
+            {
+                atomic_store_explicit(&p_node->next[l], succs[l], memory_order_relaxed);
+            }
+        }
+    }
+
+    return 0;
+}
+
+int semver_set_find(semver_set_t *p_set,
+                    const semver_t *p_semver,
+                    const semver_t **p2o_found)
+{
+    set_node_t *preds[MAX_HEIGHT];
+    set_node_t *succs[MAX_HEIGHT];
+    set_key_t key;
+
+    if(NULL == p_set || NULL == p_semver || NULL == p2o_found)
+    {
+        return -1;
+    }
+
+    make_key(p_semver, &key);
+    search(p_set, &key, preds, succs);
+
+    if(NULL == succs[0] || 0 != key_cmp(&succs[0]->key, &key))
+    {
+        return 1;
+    }
+
+    *p2o_found = succs[0]->p_semver;
+    return 0;
+}
+
+int semver_set_floor(semver_set_t *p_set,
+                     const semver_t *p_semver,
+                     const semver_t **p2o_found)
+{
+    set_node_t *preds[MAX_HEIGHT];
+    set_node_t *succs[MAX_HEIGHT];
+    set_key_t key;
+
+    if(NULL == p_set || NULL == p_semver || NULL == p2o_found)
+    {
+        return -1;
+    }
+
+    make_key(p_semver, &key);
+    search(p_set, &key, preds, succs);
+
+    if(NULL != succs[0] && 0 == key_cmp(&succs[0]->key, &key))
+    {
+        *p2o_found = succs[0]->p_semver;
+        return 0;
+    }
+
+    if(preds[0] == p_set->p_head)
+    {
+        return 1;
+    }
+
+    *p2o_found = preds[0]->p_semver;
+    return 0;
+}
+
+int semver_set_ceiling(semver_set_t *p_set,
+                       const semver_t *p_semver,
+                       const semver_t **p2o_found)
+{
+    set_node_t *preds[MAX_HEIGHT];
+    set_node_t *succs[MAX_HEIGHT];
+    set_key_t key;
+
+    if(NULL == p_set || NULL == p_semver || NULL == p2o_found)
+    {
+        return -1;
+    }
+
+    make_key(p_semver, &key);
+    search(p_set, &key, preds, succs);
+
+    if(NULL == succs[0])
+    {
+        return 1;
+    }
+
+    *p2o_found = succs[0]->p_semver;
+    return 0;
+}
+
+int semver_set_range(semver_set_t *p_set,
+                     const semver_t *p_lo,
+                     const semver_t *p_hi,
+                     semver_set_cb_t callback,
+                     void *p_ctx)
+{
+    set_node_t *preds[MAX_HEIGHT];
+    set_node_t *succs[MAX_HEIGHT];
+    set_node_t *p_node;
+    set_key_t key;
+
+    if(NULL == p_set || NULL == callback)
+    {
+        return -1;
+    }
+
+    if(NULL != p_lo)
+    {
+        make_key(p_lo, &key);
+        search(p_set, &key, preds, succs);
+        p_node = succs[0];
+    }
+    else
+    {
+        p_node = atomic_load_explicit(&p_set->p_head->next[0], memory_order_acquire);
+    }
+
+    if(NULL != p_hi)
+    {
+        make_key(p_hi, &key);
+    }
+
+    for(;NULL != p_node;p_node = atomic_load_explicit(&p_node->next[0], memory_order_acquire))
+    {
+        if(NULL != p_hi && key_cmp(&p_node->key, &key) >= 0)
+        {
+            break;
+        }
+
+        if(0 != callback(p_ctx, p_node->p_semver))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+size_t semver_set_size(semver_set_t *p_set)
+{
+    if(NULL == p_set)
+    {
+        return 0;
+    }
+
+    return atomic_load_explicit(&p_set->size, memory_order_relaxed);
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static void make_key(const semver_t *p_semver, set_key_t *po_key)
+{
+    po_key->hi = ((uint64_t)p_semver->major << 32) | p_semver->minor;
+    po_key->lo = ((uint64_t)p_semver->patch << 1) | (0 == p_semver->pr_len);
+    po_key->pr = SEMVER_TAIL(p_semver);
+    po_key->pr_len = p_semver->pr_len;
+}
+
+static int key_cmp(const set_key_t *p_a, const set_key_t *p_b)
+{
+    if(p_a->hi != p_b->hi)
+    {
+        return (p_a->hi < p_b->hi)? -1 : 1;
+    }
+
+    if(p_a->lo != p_b->lo)
+    {
+        return (p_a->lo < p_b->lo)? -1 : 1;
+    }
+
+    //Equal words and the low bit clear: both are pre-releases of the same
+    //version.
+    if(0 != (p_a->lo & 1))
+    {
+        return 0;
+    }
+
+    return semver_pr_str_cmp(p_a->pr, p_a->pr_len, p_b->pr, p_b->pr_len);
+}
+
+//Heights come from a hash of the key rather than from a shared random
+//number generator, which writers would otherwise all contend on.
+static uint32_t key_height(const set_key_t *p_key)
+{
+    uint64_t x;
+    uint32_t hash = FNV_OFFSET_BASIS;
+    uint16_t i;
+
+    for(i=0;i<p_key->pr_len;i++)
+    {
+        hash ^= (uint8_t)p_key->pr[i];
+        hash *= FNV_PRIME;
+    }
+
+    //splitmix64 finaliser, for a uniform bit pattern out of similar keys.
+    x = p_key->hi * 0x9E3779B97F4A7C15ull ^ p_key->lo ^ ((uint64_t)hash << 32);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x ^= x >> 31;
+
+    //Each trailing zero bit is one more level: p = 1/2.
+    return 1 + __builtin_ctzll(x | (1ull << (MAX_HEIGHT - 1)));
+}
+
+static set_node_t* node_create(uint32_t height)
+{
+    set_node_t *p_node;
+    uint32_t level;
+
+    p_node = (set_node_t*)malloc(sizeof(set_node_t) + height * sizeof(p_node->next[0]));
+    if(NULL == p_node)
+    {
+        return NULL;
+    }
+
+    p_node->p_semver = NULL;
+    for(level=0;level<height;level++)
+    {
+        atomic_init(&p_node->next[level], NULL);
+    }
+
+    return p_node;
+}
+
+//Fills in, for every level, the last node preceding p_key and the node
+//after it. Levels above the set's height get the head and NULL without
+//being looked at; if an insert has since raised the height, linking there
+//fails and the caller searches again.
+static void search(semver_set_t *p_set,
+                   const set_key_t *p_key,
+                   set_node_t **po_preds,
+                   set_node_t **po_succs)
+{
+    set_node_t *p_pred = p_set->p_head;
+    set_node_t *p_curr;
+    int top;
+    int level;
+
+    top = (int)atomic_load_explicit(&p_set->height, memory_order_relaxed);
+    for(level=MAX_HEIGHT-1;level>=top;level--)
+    {
+        po_preds[level] = p_pred;
+        po_succs[level] = NULL;
+    }
+
+    for(;level>=0;level--)
+    {
+        p_curr = atomic_load_explicit(&p_pred->next[level], memory_order_acquire);
+        while(NULL != p_curr && key_cmp(&p_curr->key, p_key) < 0)
+        {
+            p_pred = p_curr;
+            p_curr = atomic_load_explicit(&p_pred->next[level], memory_order_acquire);
+        }
+
+        po_preds[level] = p_pred;
+        po_succs[level] = p_curr;
+    }
+}
@@ -0,0 +1,745 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "semver.h"
+#include "semver_sort.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+/* The radix key is two words: major and minor in hi, patch and a "no
+ * pre-release" bit in lo. It is taken apart into 11-bit digits: three for
+ * the 33 bits of lo, six for hi. */
+#define DIGIT_BITS  11
+#define NUM_BUCKETS (1u << DIGIT_BITS)
+#define DIGIT_MASK  (NUM_BUCKETS - 1)
+#define LO_DIGITS   3
+#define HI_DIGITS   6
+#define NUM_DIGITS  (LO_DIGITS + HI_DIGITS)
+
+/* Runs this short are insertion sorted rather than merged. */
+#define INSERTION_MAX 16
+
+/* A parallel sort cuts the keys into several buckets per worker, so that a
+ * worker that finishes early picks up another instead of idling. */
+#define MAX_WORKERS        64
+#define BUCKETS_PER_WORKER 4
+#define SAMPLES_PER_BUCKET 16
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef struct sort_rec_
+{
+    uint64_t hi;
+    uint64_t lo;
+    size_t index;
+} sort_rec_t;
+
+/* State shared by the workers of one parallel sort. */
+typedef struct sort_shared_
+{
+    const semver_t *p_semvers;
+    size_t *po_order;
+
+    //Keys in input order, then scattered into buckets.
+    sort_rec_t *p_keys;
+    sort_rec_t *p_bucketed;
+
+    //num_buckets - 1 keys; bucket b holds keys from splitters[b-1] up to,
+    //not including, splitters[b].
+    const sort_rec_t *splitters;
+    uint32_t num_buckets;
+
+    //Per worker and bucket: first the count, then the scatter offset.
+    size_t *offsets;
+    size_t *bucket_start;
+    //Largest bucket first.
+    uint32_t *bucket_order;
+    atomic_uint next_bucket;
+} sort_shared_t;
+
+typedef struct sort_worker_
+{
+    sort_shared_t *p_shared;
+    uint32_t id;
+    size_t start;
+    size_t end;
+    size_t *counts;
+} sort_worker_t;
+
+/* Orders two indices into an array of versions. */
+typedef int (*index_cmp_t)(const semver_t *p_semvers, size_t a, size_t b);
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static int radix_order(const semver_t *p_semvers, size_t num, size_t *po_order);
+static int sample_sort_order(const semver_t *p_semvers,
+                             size_t num,
+                             uint32_t num_workers,
+                             size_t *po_order);
+static void* key_worker(void *p_arg);
+static void* scatter_worker(void *p_arg);
+static void* bucket_worker(void *p_arg);
+static int run_workers(sort_worker_t *workers,
+                       uint32_t num_workers,
+                       void* (*fn)(void*));
+static void make_rec(const semver_t *p_semvers, size_t index, sort_rec_t *po_rec);
+static int rec_cmp(const sort_rec_t *p_a, const sort_rec_t *p_b);
+static int rec_qsort_cmp(const void *p_a, const void *p_b);
+static uint32_t rec_bucket(const sort_shared_t *p_shared, const sort_rec_t *p_rec);
+static sort_rec_t* radix_recs(sort_rec_t *p_src,
+                              sort_rec_t *p_dst,
+                              size_t num,
+                              size_t *counts);
+static void finish_order(const semver_t *p_semvers,
+                         const sort_rec_t *recs,
+                         size_t num,
+                         size_t *po_order,
+                         size_t *scratch);
+static uint32_t rec_digit(const sort_rec_t *p_rec, int digit);
+static void merge_sort(size_t *items,
+                       size_t *scratch,
+                       size_t num,
+                       index_cmp_t cmp,
+                       const semver_t *p_semvers);
+static int precedence_cmp(const semver_t *p_semvers, size_t a, size_t b);
+static int pr_cmp(const semver_t *p_semvers, size_t a, size_t b);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_sort_order(const semver_t *p_semvers, size_t num, size_t *po_order)
+{
+    size_t *scratch;
+    size_t i;
+
+    if(0 == num)
+    {
+        return 0;
+    }
+
+    if(NULL == p_semvers || NULL == po_order)
+    {
+        return 1;
+    }
+
+    if(num >= SEMVER_SORT_RADIX_MIN)
+    {
+        return radix_order(p_semvers, num, po_order);
+    }
+
+    scratch = (size_t*)malloc(num * sizeof(size_t));
+    if(NULL == scratch)
+    {
+        return 1;
+    }
+
+    for(i=0;i<num;i++)
+    {
+        po_order[i] = i;
+    }
+    merge_sort(po_order, scratch, num, precedence_cmp, p_semvers);
+
+    free(scratch);
+    return 0;
+}
+
+int semver_sort(semver_t *p_semvers, size_t num)
+{
+    return semver_sort_parallel(p_semvers, num, 1);
+}
+
+int semver_sort_order_parallel(const semver_t *p_semvers,
+                               size_t num,
+                               uint32_t num_threads,
+                               size_t *po_order)
+{
+    size_t max_workers;
+    uint32_t num_workers;
+
+    if(0 == num)
+    {
+        return 0;
+    }
+
+    if(NULL == p_semvers || NULL == po_order)
+    {
+        return 1;
+    }
+
+    if(0 == num_threads)
+    {
+        long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (num_cpus > 0)? (uint32_t)num_cpus : 1;
+    }
+
+    //Don't bother splitting arrays that are small to begin with.
+    max_workers = num / SEMVER_SORT_PARALLEL_MIN;
+    num_workers = num_threads;
+    if(num_workers > max_workers)
+    {
+        num_workers = max_workers;
+    }
+    if(num_workers > MAX_WORKERS)
+    {
+        num_workers = MAX_WORKERS;
+    }
+
+    if(num_workers <= 1)
+    {
+        return semver_sort_order(p_semvers, num, po_order);
+    }
+
+    return sample_sort_order(p_semvers, num, num_workers, po_order);
+}
+
+int semver_sort_parallel(semver_t *p_semvers, size_t num, uint32_t num_threads)
+{
+    semver_t *sorted;
+    size_t *order;
+    size_t i;
+
+    if(0 == num)
+    {
+        return 0;
+    }
+
+    if(NULL == p_semvers)
+    {
+        return 1;
+    }
+
+    order = (size_t*)malloc(num * sizeof(size_t));
+    sorted = (semver_t*)malloc(num * sizeof(semver_t));
+    if(NULL == order || NULL == sorted ||
+       0 != semver_sort_order_parallel(p_semvers, num, num_threads, order))
+    {
+        free(order);
+        free(sorted);
+        return 1;
+    }
+
+    //A semver_t holds no pointers into itself, so it can be moved bitwise.
+    for(i=0;i<num;i++)
+    {
+        sorted[i] = p_semvers[order[i]];
+    }
+    memcpy(p_semvers, sorted, num * sizeof(semver_t));
+
+    free(order);
+    free(sorted);
+    return 0;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+//LSD radix sort of the version cores, least significant digit first. One
+//pass up front counts every digit; a digit that is the same for every
+//version (the high bits of small numbers, mostly) is not scattered on.
+static int radix_order(const semver_t *p_semvers, size_t num, size_t *po_order)
+{
+    sort_rec_t *recs;
+    sort_rec_t *p_sorted;
+    size_t *counts;
+    size_t i;
+    int result = 1;
+
+    recs = (sort_rec_t*)malloc(2 * num * sizeof(sort_rec_t));
+    counts = (size_t*)malloc(NUM_DIGITS * NUM_BUCKETS * sizeof(size_t));
+    if(NULL == recs || NULL == counts)
+    {
+        goto done;
+    }
+
+    for(i=0;i<num;i++)
+    {
+        make_rec(p_semvers, i, &recs[i]);
+    }
+
+    //Whichever half doesn't hold the result is free for merge scratch.
+    p_sorted = radix_recs(recs, recs + num, num, counts);
+    finish_order(p_semvers, p_sorted, num, po_order,
+                 (size_t*)((p_sorted == recs)? recs + num : recs));
+
+    result = 0;
+
+done:
+    free(recs);
+    free(counts);
+    return result;
+}
+
+//Sample sort: splitters picked from a sorted sample cut the key range into
+//buckets; each worker scatters its slice of the input into them, then the
+//workers radix sort whole buckets. Equal keys always land in one bucket and
+//are scattered in input order, so the buckets laid end to end are the
+//stable order, with no merge pass.
+static int sample_sort_order(const semver_t *p_semvers,
+                             size_t num,
+                             uint32_t num_workers,
+                             size_t *po_order)
+{
+    sort_worker_t workers[MAX_WORKERS];
+    sort_shared_t shared;
+    sort_rec_t *recs = NULL;
+    sort_rec_t *samples = NULL;
+    size_t num_samples;
+    size_t step;
+    size_t sum;
+    size_t count;
+    uint32_t num_buckets = num_workers * BUCKETS_PER_WORKER;
+    uint32_t b;
+    uint32_t k;
+    uint32_t w;
+    int result = 1;
+
+    memset(workers, 0, sizeof(workers));
+    memset(&shared, 0, sizeof(shared));
+
+    num_samples = (size_t)num_buckets * SAMPLES_PER_BUCKET;
+    recs = (sort_rec_t*)malloc(2 * num * sizeof(sort_rec_t));
+    samples = (sort_rec_t*)malloc(num_samples * sizeof(sort_rec_t));
+    shared.offsets = (size_t*)calloc((size_t)num_workers * num_buckets, sizeof(size_t));
+    shared.bucket_start = (size_t*)malloc((num_buckets + 1) * sizeof(size_t));
+    shared.bucket_order = (uint32_t*)malloc(num_buckets * sizeof(uint32_t));
+    if(NULL == recs || NULL == samples || NULL == shared.offsets ||
+       NULL == shared.bucket_start || NULL == shared.bucket_order)
+    {
+        goto done;
+    }
+
+    for(w=0;w<num_workers;w++)
+    {
+        workers[w].counts = (size_t*)malloc(NUM_DIGITS * NUM_BUCKETS * sizeof(size_t));
+        if(NULL == workers[w].counts)
+        {
+            goto done;
+        }
+        workers[w].p_shared = &shared;
+        workers[w].id = w;
+        workers[w].start = (num / num_workers) * w;
+        workers[w].end = (w == num_workers - 1)? num : (num / num_workers) * (w + 1);
+    }
+
+    //Evenly spaced rather than random, so already sorted input still
+    //splits evenly. Every SAMPLES_PER_BUCKET-th sample becomes a splitter.
+    step = num / num_samples;
+    for(k=0;k<num_samples;k++)
+    {
+        make_rec(p_semvers, k * step + step / 2, &samples[k]);
+    }
+    qsort(samples, num_samples, sizeof(sort_rec_t), rec_qsort_cmp);
+    for(b=1;b<num_buckets;b++)
+    {
+        samples[b-1] = samples[b * SAMPLES_PER_BUCKET];
+    }
+
+    shared.p_semvers = p_semvers;
+    shared.po_order = po_order;
+    shared.p_keys = recs;
+    shared.p_bucketed = recs + num;
+    shared.splitters = samples;
+    shared.num_buckets = num_buckets;
+
+    if(0 != run_workers(workers, num_workers, key_worker))
+    {
+        goto done;
+    }
+
+    //Offsets bucket by bucket, and within a bucket worker by worker, which
+    //is input order.
+    sum = 0;
+    for(b=0;b<num_buckets;b++)
+    {
+        shared.bucket_start[b] = sum;
+        for(w=0;w<num_workers;w++)
+        {
+            count = shared.offsets[w * num_buckets + b];
+            shared.offsets[w * num_buckets + b] = sum;
+            sum += count;
+        }
+    }
+    shared.bucket_start[num_buckets] = num;
+
+    if(0 != run_workers(workers, num_workers, scatter_worker))
+    {
+        goto done;
+    }
+
+    //Handing out the largest buckets first keeps one big straggler from
+    //finishing long after the rest.
+    for(b=0;b<num_buckets;b++)
+    {
+        count = shared.bucket_start[b+1] - shared.bucket_start[b];
+        for(k=b;k>0;k--)
+        {
+            uint32_t prev = shared.bucket_order[k-1];
+
+            if(shared.bucket_start[prev+1] - shared.bucket_start[prev] >= count)
+            {
+                break;
+            }
+            shared.bucket_order[k] = prev;
+        }
+        shared.bucket_order[k] = b;
+    }
+    atomic_init(&shared.next_bucket, 0);
+
+    if(0 != run_workers(workers, num_workers, bucket_worker))
+    {
+        goto done;
+    }
+
+    result = 0;
+
+done:
+    for(w=0;w<num_workers;w++)
+    {
+        free(workers[w].counts);
+    }
+    free(recs);
+    free(samples);
+    free(shared.offsets);
+    free(shared.bucket_start);
+    free(shared.bucket_order);
+    return result;
+}
+
+static void* key_worker(void *p_arg)
+{
+    sort_worker_t *p_worker = (sort_worker_t*)p_arg;
+    sort_shared_t *p_shared = p_worker->p_shared;
+    size_t *counts = &p_shared->offsets[p_worker->id * p_shared->num_buckets];
+    size_t i;
+
+    for(i=p_worker->start;i<p_worker->end;i++)
+    {
+        make_rec(p_shared->p_semvers, i, &p_shared->p_keys[i]);
+        counts[rec_bucket(p_shared, &p_shared->p_keys[i])]++;
+    }
+
+    return NULL;
+}
+
+//Looks each bucket up again rather than storing it; the search is a
+//handful of compares against splitters that stay in cache.
+static void* scatter_worker(void *p_arg)
+{
+    sort_worker_t *p_worker = (sort_worker_t*)p_arg;
+    sort_shared_t *p_shared = p_worker->p_shared;
+    size_t *offsets = &p_shared->offsets[p_worker->id * p_shared->num_buckets];
+    size_t i;
+
+    for(i=p_worker->start;i<p_worker->end;i++)
+    {
+        const sort_rec_t *p_rec = &p_shared->p_keys[i];
+
+        p_shared->p_bucketed[offsets[rec_bucket(p_shared, p_rec)]++] = *p_rec;
+    }
+
+    return NULL;
+}
+
+static void* bucket_worker(void *p_arg)
+{
+    sort_worker_t *p_worker = (sort_worker_t*)p_arg;
+    sort_shared_t *p_shared = p_worker->p_shared;
+    sort_rec_t *p_sorted;
+    sort_rec_t *p_spare;
+    size_t start;
+    size_t num;
+    uint32_t k;
+    uint32_t b;
+
+    while((k = atomic_fetch_add_explicit(&p_shared->next_bucket, 1, memory_order_relaxed)) <
+          p_shared->num_buckets)
+    {
+        b = p_shared->bucket_order[k];
+        start = p_shared->bucket_start[b];
+        num = p_shared->bucket_start[b+1] - start;
+        if(0 == num)
+        {
+            continue;
+        }
+
+        //The bucket's range of the input-order keys is no longer needed
+        //and serves as its ping-pong buffer.
+        p_sorted = radix_recs(&p_shared->p_bucketed[start], &p_shared->p_keys[start],
+                              num, p_worker->counts);
+        p_spare = (p_sorted == &p_shared->p_bucketed[start])?
+                  &p_shared->p_keys[start] : &p_shared->p_bucketed[start];
+        finish_order(p_shared->p_semvers, p_sorted, num,
+                     &p_shared->po_order[start], (size_t*)p_spare);
+    }
+
+    return NULL;
+}
+
+//Runs fn over every worker; the calling thread takes the first one itself.
+static int run_workers(sort_worker_t *workers,
+                       uint32_t num_workers,
+                       void* (*fn)(void*))
+{
+    pthread_t threads[MAX_WORKERS];
+    uint32_t num_started = 0;
+    uint32_t i;
+    int result = 0;
+
+    for(i=1;i<num_workers;i++)
+    {
+        if(0 != pthread_create(&threads[i], NULL, fn, &workers[i]))
+        {
+            result = 1;
+            break;
+        }
+        num_started = i;
+    }
+
+    fn(&workers[0]);
+
+    for(i=1;i<=num_started;i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    return result;
+}
+
+static void make_rec(const semver_t *p_semvers, size_t index, sort_rec_t *po_rec)
+{
+    const semver_t *p_semver = &p_semvers[index];
+
+    po_rec->hi = ((uint64_t)p_semver->major << 32) | p_semver->minor;
+    po_rec->lo = ((uint64_t)p_semver->patch << 1) | (0 == p_semver->pr_len);
+    po_rec->index = index;
+}
+
+static int rec_cmp(const sort_rec_t *p_a, const sort_rec_t *p_b)
+{
+    if(p_a->hi != p_b->hi)
+    {
+        return (p_a->hi < p_b->hi)? -1 : 1;
+    }
+
+    if(p_a->lo != p_b->lo)
+    {
+        return (p_a->lo < p_b->lo)? -1 : 1;
+    }
+
+    return 0;
+}
+
+static int rec_qsort_cmp(const void *p_a, const void *p_b)
+{
+    return rec_cmp((const sort_rec_t*)p_a, (const sort_rec_t*)p_b);
+}
+
+//The number of splitters at or below the key.
+static uint32_t rec_bucket(const sort_shared_t *p_shared, const sort_rec_t *p_rec)
+{
+    uint32_t lo = 0;
+    uint32_t hi = p_shared->num_buckets - 1;
+    uint32_t mid;
+
+    while(lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        if(rec_cmp(&p_shared->splitters[mid], p_rec) <= 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+//LSD radix sort of the version cores, least significant digit first. One
+//pass up front counts every digit; a digit that is the same for every
+//version (the high bits of small numbers, mostly) is not scattered on.
+//Returns whichever of the two buffers ends up holding the sorted keys.
+static sort_rec_t* radix_recs(sort_rec_t *p_src,
+                              sort_rec_t *p_dst,
+                              size_t num,
+                              size_t *counts)
+{
+    sort_rec_t *p_tmp;
+    size_t sum;
+    size_t count;
+    size_t i;
+    size_t j;
+    int digit;
+
+    memset(counts, 0, NUM_DIGITS * NUM_BUCKETS * sizeof(size_t));
+    for(i=0;i<num;i++)
+    {
+        for(digit=0;digit<NUM_DIGITS;digit++)
+        {
+            counts[digit * NUM_BUCKETS + rec_digit(&p_src[i], digit)]++;
+        }
+    }
+
+    for(digit=0;digit<NUM_DIGITS;digit++)
+    {
+        size_t *offsets = &counts[digit * NUM_BUCKETS];
+
+        if(num == offsets[rec_digit(&p_src[0], digit)])
+        {
+            continue;
+        }
+
+        sum = 0;
+        for(j=0;j<NUM_BUCKETS;j++)
+        {
+            count = offsets[j];
+            offsets[j] = sum;
+            sum += count;
+        }
+
+        for(i=0;i<num;i++)
+        {
+            p_dst[offsets[rec_digit(&p_src[i], digit)]++] = p_src[i];
+        }
+
+        p_tmp = p_src;
+        p_src = p_dst;
+        p_dst = p_tmp;
+    }
+
+    return p_src;
+}
+
+//Writes out the order of radix sorted keys. The cores are sorted;
+//pre-releases sharing one still need ordering among themselves, for which
+//scratch must hold num indices.
+static void finish_order(const semver_t *p_semvers,
+                         const sort_rec_t *recs,
+                         size_t num,
+                         size_t *po_order,
+                         size_t *scratch)
+{
+    size_t i;
+    size_t j;
+
+    for(i=0;i<num;i++)
+    {
+        po_order[i] = recs[i].index;
+    }
+
+    for(i=0;i<num;i=j)
+    {
+        for(j=i+1;j<num && recs[j].hi == recs[i].hi && recs[j].lo == recs[i].lo;j++)
+        {
+        }
+
+        if(j - i > 1 && 0 == (recs[i].lo & 1))
+        {
+            merge_sort(&po_order[i], scratch, j - i, pr_cmp, p_semvers);
+        }
+    }
+}
+
+static uint32_t rec_digit(const sort_rec_t *p_rec, int digit)
+{
+    if(digit < LO_DIGITS)
+    {
+        return (p_rec->lo >> (digit * DIGIT_BITS)) & DIGIT_MASK;
+    }
+
+    return (p_rec->hi >> ((digit - LO_DIGITS) * DIGIT_BITS)) & DIGIT_MASK;
+}
+
+//Stable: of two equal items, the one from the left half goes first.
+static void merge_sort(size_t *items,
+                       size_t *scratch,
+                       size_t num,
+                       index_cmp_t cmp,
+                       const semver_t *p_semvers)
+{
+    size_t half;
+    size_t i;
+    size_t j;
+    size_t k;
+
+    if(num <= INSERTION_MAX)
+    {
+        for(i=1;i<num;i++)
+        {
+            size_t item = items[i];
+
+            for(j=i;j>0 && cmp(p_semvers, items[j-1], item) > 0;j--)
+            {
+                items[j] = items[j-1];
+            }
+            items[j] = item;
+        }
+        return;
+    }
+
+    half = num / 2;
+    merge_sort(items, scratch, half, cmp, p_semvers);
+    merge_sort(items + half, scratch, num - half, cmp, p_semvers);
+
+    if(cmp(p_semvers, items[half-1], items[half]) <= 0)
+    {
+        return;
+    }
+
+    //Only the left half is copied out; the merge never overtakes the
+    //right half it is still reading.
+    memcpy(scratch, items, half * sizeof(size_t));
+    for(i=0,j=half,k=0;i<half && j<num;k++)
+    {
+        if(cmp(p_semvers, scratch[i], items[j]) <= 0)
+        {
+            items[k] = scratch[i++];
+        }
+        else
+        {
+            items[k] = items[j++];
+        }
+    }
+    memcpy(&items[k], &scratch[i], (half - i) * sizeof(size_t));
+}
+
+static int precedence_cmp(const semver_t *p_semvers, size_t a, size_t b)
+{
+    int result = 0;
+
+    semver_compare(&p_semvers[a], &p_semvers[b], &result);
+    return result;
+}
+
+static int pr_cmp(const semver_t *p_semvers, size_t a, size_t b)
+{
+    return semver_pr_str_cmp(SEMVER_TAIL(&p_semvers[a]), p_semvers[a].pr_len,
+                             SEMVER_TAIL(&p_semvers[b]), p_semvers[b].pr_len);
+}
@@ -0,0 +1,216 @@
+/* Copyright 2015, Brandon Kinman
+ * This file is part of The semver library.
+ *
+ * semver library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * semver library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Foobar.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "semver.h"
+#include "semver_stream.h"
+#include "semver_private.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define IS_DELIMITER(c) (' ' == (c) || '\n' == (c) || '\r' == (c) || \
+                         '\t' == (c) || '\0' == (c))
+
+#if SEMVER_STREAM_MAX_TOKEN_LEN > UINT16_MAX
+#error "SEMVER_STREAM_MAX_TOKEN_LEN must fit the parser's 16 bit lengths"
+#endif
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void token_continue(semver_stream_t *p_stream,
+                           const char* str,
+                           size_t len);
+static int token_end(semver_stream_t *p_stream,
+                     const char* str,
+                     size_t len);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+int semver_stream_init(semver_stream_t *po_stream,
+                       semver_stream_cb_t callback,
+                       void *p_ctx)
+{
+    if(NULL == po_stream || NULL == callback)
+    {
+        return 1;
+    }
+
+    po_stream->callback = callback;
+    po_stream->p_ctx = p_ctx;
+    po_stream->num_valid = 0;
+    po_stream->num_invalid = 0;
+    po_stream->in_token = false;
+    po_stream->dfa_state = SEMVER_DFA_START;
+    po_stream->token_len = 0;
+
+    return semver_init(&po_stream->semver);
+}
+
+int semver_stream_feed(semver_stream_t *p_stream,
+                       const char* chunk,
+                       size_t len)
+{
+    size_t pos = 0;
+
+    if(NULL == p_stream || (NULL == chunk && 0 != len))
+    {
+        return -1;
+    }
+
+    while(pos < len)
+    {
+        size_t start;
+
+        if(!p_stream->in_token)
+        {
+            while(pos < len && IS_DELIMITER(chunk[pos]))
+            {
+                pos++;
+            }
+            if(pos == len)
+            {
+                break;
+            }
+            p_stream->in_token = true;
+        }
+
+        start = pos;
+        while(pos < len && !IS_DELIMITER(chunk[pos]))
+        {
+            pos++;
+        }
+
+        if(pos == len)
+        {
+            //The token runs on into the next chunk.
+            token_continue(p_stream, chunk + start, pos - start);
+            break;
+        }
+
+        if(0 != token_end(p_stream, chunk + start, pos - start))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int semver_stream_finish(semver_stream_t *p_stream)
+{
+    int result = 0;
+
+    if(NULL == p_stream)
+    {
+        return -1;
+    }
+
+    if(p_stream->in_token)
+    {
+        result = (0 == token_end(p_stream, "", 0))? 0 : -1;
+    }
+
+    semver_fini(&p_stream->semver);
+    return result;
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+//Takes in the next piece of the current token, which the chunk ends
+//before the token does.
+static void token_continue(semver_stream_t *p_stream,
+                           const char* str,
+                           size_t len)
+{
+    //Once the DFA is dead, or the token too long, the rest of it is only
+    //counted, never copied.
+    if(SEMVER_DFA_DEAD != p_stream->dfa_state &&
+       len <= SEMVER_STREAM_MAX_TOKEN_LEN - p_stream->token_len)
+    {
+        p_stream->dfa_state = semver_dfa_feed(p_stream->dfa_state, str, len);
+        memcpy(p_stream->carry + p_stream->token_len, str, len);
+        p_stream->token_len += len;
+    }
+    else
+    {
+        p_stream->dfa_state = SEMVER_DFA_DEAD;
+    }
+}
+
+//Takes in the last piece of the current token, and reports it.
+static int token_end(semver_stream_t *p_stream,
+                     const char* str,
+                     size_t len)
+{
+    const char* token = str;
+    uint32_t token_len = len;
+    int result;
+
+    if(0 != p_stream->token_len)
+    {
+        //Part of the token came in an earlier chunk; finish it in the
+        //carry buffer.
+        token_continue(p_stream, str, len);
+        token = p_stream->carry;
+        token_len = p_stream->token_len;
+    }
+    else if(len <= SEMVER_STREAM_MAX_TOKEN_LEN)
+    {
+        p_stream->dfa_state = semver_dfa_feed(p_stream->dfa_state, str, len);
+    }
+    else
+    {
+        p_stream->dfa_state = SEMVER_DFA_DEAD;
+    }
+
+    result = 1;
+    if(semver_dfa_accepts(p_stream->dfa_state))
+    {
+        //The DFA has settled the grammar; parsing still checks ranges and
+        //leading zeros.
+        result = semver_parse_into(&p_stream->semver, token, token_len);
+    }
+
+    p_stream->in_token = false;
+    p_stream->dfa_state = SEMVER_DFA_START;
+    p_stream->token_len = 0;
+
+    if(result < 0)
+    {
+        return -1;
+    }
+
+    if(0 == result)
+    {
+        p_stream->num_valid++;
+        p_stream->callback(p_stream->p_ctx, &p_stream->semver);
+    }
+    else
+    {
+        p_stream->num_invalid++;
+    }
+
+    return 0;
+}
@@ -2,13 +2,16 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "unity.h"
 #include "semver.h"
+#include "semver_private.h"
 
 /******************************************************************************
  * Defines
  ******************************************************************************/
+#define NUM_FROZEN_THREADS 8
 
 /******************************************************************************
  * Typedefs
@@ -54,12 +57,18 @@ char *g_invalid_semver_strings[] =
     "1.0.0+b[\\]^_`uild", // [,\,],^,_,` are between A-z, but not A-Za-z
     "1.0.0+build-acbe.", // trailing period 
     "1.0.0+build.!@#$%",
+    "01.0.0",
+    "1.00.0",
+    "1.0.0-alpha.01",
+    "4294967296.0.0",
+    "1.99999999999999999999.0",
 };
 
 
 /******************************************************************************
  * static function prototypes
  ******************************************************************************/
+static void* frozen_thread(void *p_arg);
 
 /******************************************************************************
  * non-static function definitions
@@ -87,6 +96,43 @@ void test_semver_create_destroy(void)
     return;
 }
 
+void test_semver_init_fini(void)
+{
+    semver_t semvers[3];
+    char *p_str;
+    int str_len;
+    int i;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_init(NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_fini(NULL));
+
+    //Semvers held by value, no semver_create involved.
+    for(i=0;i<3;i++)
+    {
+        TEST_ASSERT_EQUAL(0, semver_init(&semvers[i]));
+    }
+    TEST_ASSERT_EQUAL(0, semver_parse_into(&semvers[0], "1.0.0-alpha+001", 15));
+    TEST_ASSERT_EQUAL(0, semver_parse_into(&semvers[1], "1.0.0", 5));
+
+    semver_to_str(&semvers[2], &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("0.0.0", p_str);
+    free(p_str);
+
+    TEST_ASSERT_EQUAL(0, semver_compare(&semvers[0], &semvers[1], &i));
+    TEST_ASSERT_EQUAL(-1, i);
+
+    //Finalized semvers are as good as new.
+    TEST_ASSERT_EQUAL(0, semver_fini(&semvers[0]));
+    semver_to_str(&semvers[0], &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("0.0.0", p_str);
+    free(p_str);
+
+    for(i=0;i<3;i++)
+    {
+        semver_fini(&semvers[i]);
+    }
+}
+
 void test_semver_get_set_major_minor_patch(void)
 {
     semver_t *p_semver;
@@ -180,6 +226,181 @@ void test_set_get_bmd_str(void)
     semver_destroy(p_semver);
 }
 
+void test_semver_get_str(void)
+{
+    char semver_str[] = "1.2.3-alpha.9+build.5";
+    semver_t *p_semver = NULL;
+    const char* str;
+    const char* again;
+    size_t len;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_get_str(NULL, &str, &len));
+
+    //Borrowed text is copied before the string is added behind it.
+    TEST_ASSERT_EQUAL(0, semver_parse_ex(semver_str, strlen(semver_str), SEMVER_NO_COPY, &p_semver));
+    TEST_ASSERT_EQUAL(0, semver_get_str(p_semver, &str, &len));
+    TEST_ASSERT_EQUAL_STRING(semver_str, str);
+    TEST_ASSERT_EQUAL(strlen(semver_str), len);
+
+    //Built once, then handed out as is.
+    TEST_ASSERT_EQUAL(0, semver_get_str(p_semver, &again, &len));
+    TEST_ASSERT_EQUAL_PTR(str, again);
+
+    //Every change shows.
+    semver_set_minor(p_semver, 7);
+    semver_get_str(p_semver, &str, &len);
+    TEST_ASSERT_EQUAL_STRING("1.7.3-alpha.9+build.5", str);
+
+    semver_bump_prerelease(p_semver);
+    semver_get_str(p_semver, &str, &len);
+    TEST_ASSERT_EQUAL_STRING("1.7.3-alpha.10", str);
+
+    semver_set_bmd_str(p_semver, "a-much-longer-build-meta-data.string", 36);
+    semver_get_str(p_semver, &str, &len);
+    TEST_ASSERT_EQUAL_STRING("1.7.3-alpha.10+a-much-longer-build-meta-data.string", str);
+
+    semver_set_pr_str(p_semver, "rc.1", 4);
+    semver_get_str(p_semver, &str, &len);
+    TEST_ASSERT_EQUAL_STRING("1.7.3-rc.1+a-much-longer-build-meta-data.string", str);
+
+    semver_bump_major(p_semver);
+    semver_get_str(p_semver, &str, &len);
+    TEST_ASSERT_EQUAL_STRING("2.0.0", str);
+    TEST_ASSERT_EQUAL(5, len);
+
+    TEST_ASSERT_EQUAL(0, semver_parse_into(p_semver, "4294967295.0.1", 14));
+    semver_get_str(p_semver, &str, &len);
+    TEST_ASSERT_EQUAL_STRING("4294967295.0.1", str);
+
+    semver_destroy(p_semver);
+}
+
+void test_semver_get_str_stays_inline(void)
+{
+    semver_t semver;
+    const char* str;
+    size_t len;
+
+    //"\0\0" plus the string and its terminator: 8 bytes.
+    semver_init(&semver);
+    TEST_ASSERT_EQUAL(0, semver_parse_into(&semver, "1.2.3", 5));
+    TEST_ASSERT_EQUAL(0, semver_get_str(&semver, &str, &len));
+    TEST_ASSERT_EQUAL_STRING("1.2.3", str);
+    TEST_ASSERT_NULL(semver.tail);
+    TEST_ASSERT_TRUE(str >= semver.inline_tail &&
+                     str + len < semver.inline_tail + SEMVER_INLINE_TAIL_LEN);
+
+    //"rc.1\0b\0" plus 15 bytes of string and a terminator: 23 bytes.
+    TEST_ASSERT_EQUAL(0, semver_parse_into(&semver, "10.20.30-rc.1+b", 15));
+    TEST_ASSERT_EQUAL(0, semver_get_str(&semver, &str, &len));
+    TEST_ASSERT_EQUAL_STRING("10.20.30-rc.1+b", str);
+    TEST_ASSERT_NULL(semver.tail);
+
+    //Largest numbers, no text: 2 + 32 + 1 bytes no longer fit.
+    TEST_ASSERT_EQUAL(0, semver_parse_into(&semver, "4294967295.4294967295.4294967295", 32));
+    TEST_ASSERT_EQUAL(0, semver_get_str(&semver, &str, &len));
+    TEST_ASSERT_EQUAL_STRING("4294967295.4294967295.4294967295", str);
+    TEST_ASSERT_NOT_NULL(semver.tail);
+
+    semver_fini(&semver);
+}
+
+void test_semver_freeze(void)
+{
+    char semver_str[] = "1.0.0-alpha.1.a-rather-long-identifier+build.5";
+    const semver_t *frozen[2];
+    semver_t *p_semver = NULL;
+    pthread_t threads[NUM_FROZEN_THREADS];
+    char *p_str;
+    int result;
+    int len;
+    int i;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_freeze(NULL, &frozen[0]));
+    TEST_ASSERT_NOT_EQUAL(0, semver_unref(NULL));
+
+    //Long text goes behind the struct, short text inline; either way the
+    //copy outlives the original, even one that borrowed its text.
+    TEST_ASSERT_EQUAL(0, semver_parse_ex(semver_str, strlen(semver_str), SEMVER_NO_COPY, &p_semver));
+    TEST_ASSERT_EQUAL(0, semver_freeze(p_semver, &frozen[0]));
+    TEST_ASSERT_EQUAL(0, semver_parse_into(p_semver, "1.0.0-alpha", 11));
+    TEST_ASSERT_EQUAL(0, semver_freeze(p_semver, &frozen[1]));
+    semver_destroy(p_semver);
+    memset(semver_str, 'x', sizeof(semver_str) - 1);
+
+    TEST_ASSERT_EQUAL(0, semver_to_str(frozen[0], &p_str, &len));
+    TEST_ASSERT_EQUAL_STRING("1.0.0-alpha.1.a-rather-long-identifier+build.5", p_str);
+    free(p_str);
+    TEST_ASSERT_EQUAL(0, semver_compare(frozen[1], frozen[0], &result));
+    TEST_ASSERT_EQUAL(-1, result);
+
+    //Threads share both, each with a reference of its own.
+    for(i=0;i<NUM_FROZEN_THREADS;i++)
+    {
+        semver_ref(frozen[0]);
+        semver_ref(frozen[1]);
+        pthread_create(&threads[i], NULL, frozen_thread, (void*)frozen);
+    }
+    semver_unref(frozen[0]);
+    semver_unref(frozen[1]);
+
+    for(i=0;i<NUM_FROZEN_THREADS;i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+void test_semver_spans(void)
+{
+    static const char* ids[] = { "alpha", "1", "x-7", "0" };
+    char semver_str[] = "1.0.0-alpha.1.x-7.0+build.5";
+    semver_t *p_semver = NULL;
+    const char* str;
+    size_t len;
+    semver_id_type_t type;
+    uint32_t flags;
+    int i;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_get_pr_span(NULL, &str, &len));
+    TEST_ASSERT_TRUE(semver_pr_count(NULL) < 0);
+
+    //Stored, then borrowed straight from the parsed string.
+    for(flags=0;flags<=SEMVER_NO_COPY;flags+=SEMVER_NO_COPY)
+    {
+        TEST_ASSERT_EQUAL(0, semver_parse_ex(semver_str, strlen(semver_str), flags, &p_semver));
+
+        TEST_ASSERT_EQUAL(0, semver_get_pr_span(p_semver, &str, &len));
+        TEST_ASSERT_EQUAL(13, len);
+        TEST_ASSERT_EQUAL_MEMORY("alpha.1.x-7.0", str, len);
+        TEST_ASSERT_EQUAL(0, semver_get_bmd_span(p_semver, &str, &len));
+        TEST_ASSERT_EQUAL(7, len);
+        TEST_ASSERT_EQUAL_MEMORY("build.5", str, len);
+
+        TEST_ASSERT_EQUAL(4, semver_pr_count(p_semver));
+        for(i=0;i<4;i++)
+        {
+            TEST_ASSERT_EQUAL(0, semver_pr_at(p_semver, i, &str, &len, &type));
+            TEST_ASSERT_EQUAL(strlen(ids[i]), len);
+            TEST_ASSERT_EQUAL_MEMORY(ids[i], str, len);
+            TEST_ASSERT_EQUAL((1 == i || 3 == i)? SEMVER_ID_NUMERIC : SEMVER_ID_ALPHANUMERIC, type);
+        }
+        TEST_ASSERT_NOT_EQUAL(0, semver_pr_at(p_semver, 4, &str, &len, NULL));
+
+        semver_destroy(p_semver);
+    }
+
+    //Absent components are empty spans.
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver("1.0.0", 5, &p_semver));
+    TEST_ASSERT_EQUAL(0, semver_get_pr_span(p_semver, &str, &len));
+    TEST_ASSERT_NULL(str);
+    TEST_ASSERT_EQUAL(0, len);
+    TEST_ASSERT_EQUAL(0, semver_get_bmd_span(p_semver, &str, &len));
+    TEST_ASSERT_NULL(str);
+    TEST_ASSERT_EQUAL(0, semver_pr_count(p_semver));
+    TEST_ASSERT_NOT_EQUAL(0, semver_pr_at(p_semver, 0, &str, &len, NULL));
+    semver_destroy(p_semver);
+}
+
 void test_semver_compare_basic(void)
 {
     semver_t *p_sva = NULL;
@@ -220,6 +441,43 @@ void test_semver_compare_basic(void)
     semver_destroy(p_svb);
 }
 
+void test_semver_compare_pre_release(void)
+{
+    //From the spec, in increasing order of precedence.
+    char *ordered[] =
+    {
+        "1.0.0-alpha",
+        "1.0.0-alpha.1",
+        "1.0.0-alpha.beta",
+        "1.0.0-beta",
+        "1.0.0-beta.2",
+        "1.0.0-beta.11",
+        "1.0.0-rc.1",
+        "1.0.0",
+        "3000000000.0.0",
+    };
+    semver_t *p_sva = NULL;
+    semver_t *p_svb = NULL;
+    int result = 0;
+    int i;
+
+    for(i=0;i<sizeof(ordered)/sizeof(char*) - 1;i++)
+    {
+        semver_str_to_semver(ordered[i], strlen(ordered[i]), &p_sva);
+        semver_str_to_semver(ordered[i+1], strlen(ordered[i+1]), &p_svb);
+
+        TEST_ASSERT_EQUAL(0, semver_compare(p_sva, p_svb, &result));
+        TEST_ASSERT_EQUAL(-1, result);
+        TEST_ASSERT_EQUAL(0, semver_compare(p_svb, p_sva, &result));
+        TEST_ASSERT_EQUAL(1, result);
+        TEST_ASSERT_EQUAL(0, semver_compare(p_sva, p_sva, &result));
+        TEST_ASSERT_EQUAL(0, result);
+
+        semver_destroy(p_sva);
+        semver_destroy(p_svb);
+    }
+}
+
 void test_semver_to_str(void)
 {
     semver_t *p_sva = NULL;
@@ -273,6 +531,120 @@ void test_semver_str_is_valid(void)
 
 }
 
+void test_semver_str_is_valid_unterminated(void)
+{
+    char frame[] = "{\"version\":\"1.0.0-rc.1+b.7\"}";
+    char *p_exact;
+    int i;
+
+    //In place, in the middle of a larger buffer.
+    TEST_ASSERT_EQUAL(0, semver_str_is_valid(frame + 12, 14));
+    TEST_ASSERT_EQUAL(0, semver_str_is_valid(frame + 12, 10));
+    TEST_ASSERT_NOT_EQUAL(0, semver_str_is_valid(frame + 12, 6));
+    TEST_ASSERT_NOT_EQUAL(0, semver_str_is_valid(frame + 12, 15));
+
+    //No byte past the given length is read, terminator or not.
+    for(i=0;i<sizeof(g_valid_semver_strings)/sizeof(char*);i++)
+    {
+        size_t len = strlen(g_valid_semver_strings[i]);
+
+        p_exact = (char*)malloc(len);
+        memcpy(p_exact, g_valid_semver_strings[i], len);
+        TEST_ASSERT_EQUAL(0, semver_str_is_valid(p_exact, len));
+        free(p_exact);
+    }
+}
+
+void test_semver_validator_engines_agree(void)
+{
+    static const char alphabet[] = "0123456789.-+aZ!";
+    char str[48];
+    bool flags_a[3];
+    bool flags_b[3];
+    int result_a;
+    int result_b;
+    int i;
+    int j;
+
+    for(i=0;i<sizeof(g_valid_semver_strings)/sizeof(char*);i++)
+    {
+        TEST_ASSERT_EQUAL(0, semver_str_validator_table(g_valid_semver_strings[i],
+                                                        strlen(g_valid_semver_strings[i]),
+                                                        NULL, NULL, NULL));
+    }
+
+    //Valid strings with a random byte or two swapped for one of the
+    //interesting ones (NUL included), truncated at random; both engines
+    //must agree on the verdict and on the parts found.
+    srand(2015);
+    for(i=0;i<100000;i++)
+    {
+        const char* p_valid = g_valid_semver_strings[rand() % (sizeof(g_valid_semver_strings)/sizeof(char*))];
+        int len = strlen(p_valid);
+
+        memcpy(str, p_valid, len);
+        for(j=rand()%3;j>0;j--)
+        {
+            str[rand() % len] = (0 == rand() % 16)? '\0' : alphabet[rand() % (sizeof(alphabet) - 1)];
+        }
+        len -= (0 == rand() % 4)? rand() % len : 0;
+
+        memset(flags_a, 0, sizeof(flags_a));
+        memset(flags_b, 0, sizeof(flags_b));
+        result_a = semver_str_validator_re2c(str, len, &flags_a[0], &flags_a[1], &flags_a[2]);
+        result_b = semver_str_validator_table(str, len, &flags_b[0], &flags_b[1], &flags_b[2]);
+
+        TEST_ASSERT_EQUAL(result_a, result_b);
+        TEST_ASSERT_EQUAL_MEMORY(flags_a, flags_b, sizeof(flags_a));
+    }
+}
+
+void test_semver_validate_many(void)
+{
+    static const char alphabet[] = "0123456789.-+aZ!";
+    //Not a multiple of the lane count, so a partial group is exercised.
+    enum { NUM_STRS = 1001 };
+    static char strs[NUM_STRS][48];
+    const char* ptrs[NUM_STRS];
+    size_t lens[NUM_STRS];
+    uint8_t status[NUM_STRS];
+    int i;
+    int j;
+
+    TEST_ASSERT_EQUAL(0, semver_validate_many(NULL, NULL, 0, NULL));
+    TEST_ASSERT_TRUE(semver_validate_many(ptrs, lens, 1, NULL) < 0);
+
+    //Mutated and truncated valid strings, plus the invalid ones and a NULL,
+    //must get the same verdict as one at a time.
+    srand(2016);
+    for(i=0;i<NUM_STRS;i++)
+    {
+        const char* p_src = (0 == i % 5)?
+            g_invalid_semver_strings[rand() % (sizeof(g_invalid_semver_strings)/sizeof(char*))] :
+            g_valid_semver_strings[rand() % (sizeof(g_valid_semver_strings)/sizeof(char*))];
+        int len = strlen(p_src);
+
+        memcpy(strs[i], p_src, len);
+        for(j=rand()%3;j>0;j--)
+        {
+            strs[i][rand() % len] = (0 == rand() % 16)? '\0' : alphabet[rand() % (sizeof(alphabet) - 1)];
+        }
+        ptrs[i] = strs[i];
+        lens[i] = len - ((0 == rand() % 4)? rand() % len : 0);
+    }
+    ptrs[7] = NULL;
+
+    TEST_ASSERT_EQUAL(0, semver_validate_many(ptrs, lens, NUM_STRS, status));
+    TEST_ASSERT_EQUAL(1, status[7]);
+    for(i=0;i<NUM_STRS;i++)
+    {
+        if(NULL != ptrs[i])
+        {
+            TEST_ASSERT_EQUAL(0 != semver_str_is_valid(ptrs[i], lens[i]), status[i]);
+        }
+    }
+}
+
 void test_semver_str_to_semver(void)
 {
     char semver_str[] = "5.4.3-rc.3.2.1+sha.5114f85";
@@ -294,6 +666,266 @@ void test_semver_str_to_semver(void)
     TEST_ASSERT_EQUAL_STRING(semver_str,p_new_semver_str);
 }
 
+void test_semver_str_to_semver_core(void)
+{
+    semver_t *p_semver = NULL;
+
+    TEST_ASSERT_TRUE(semver_str_to_semver("4294967295.12345678.1234567890123", 33, &p_semver) > 0);
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver("4294967295.12345678.123456789", 29, &p_semver));
+    TEST_ASSERT_EQUAL_UINT32(4294967295u, p_semver->major);
+    TEST_ASSERT_EQUAL_UINT32(12345678u, p_semver->minor);
+    TEST_ASSERT_EQUAL_UINT32(123456789u, p_semver->patch);
+    semver_destroy(p_semver);
+
+    //Leading zeros are fine in build meta-data and non-numeric identifiers.
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver("0.0.0-0a.0+007", 14, &p_semver));
+    semver_destroy(p_semver);
+}
+
+void test_semver_round_trip(void)
+{
+    semver_t *p_semver;
+    char *p_semver_str;
+    int semver_str_len;
+    int i;
+
+    //Every valid string must come back out unchanged.
+    for(i=0;i<sizeof(g_valid_semver_strings)/sizeof(char*);i++)
+    {
+        p_semver = NULL;
+        TEST_ASSERT_EQUAL(0, semver_str_to_semver(g_valid_semver_strings[i],
+                                                  strlen(g_valid_semver_strings[i]),
+                                                  &p_semver));
+        TEST_ASSERT_EQUAL(0, semver_to_str(p_semver, &p_semver_str, &semver_str_len));
+        TEST_ASSERT_EQUAL_STRING(g_valid_semver_strings[i], p_semver_str);
+        TEST_ASSERT_EQUAL(strlen(g_valid_semver_strings[i]), semver_str_len);
+
+        free(p_semver_str);
+        semver_destroy(p_semver);
+    }
+
+    //The pre-release and build meta-data share storage; replacing one
+    //must leave the other intact.
+    semver_create(&p_semver);
+    TEST_ASSERT_EQUAL(0, semver_set_bmd_str(p_semver, "build.7", 7));
+    TEST_ASSERT_EQUAL(0, semver_set_pr_str(p_semver, "alpha.1", 7));
+    TEST_ASSERT_EQUAL(0, semver_set_pr_str(p_semver, "rc.1234567", 10));
+    TEST_ASSERT_EQUAL(0, semver_to_str(p_semver, &p_semver_str, &semver_str_len));
+    TEST_ASSERT_EQUAL_STRING("0.0.0-rc.1234567+build.7", p_semver_str);
+    free(p_semver_str);
+    semver_destroy(p_semver);
+}
+
+void test_semver_parse_ex(void)
+{
+    char semver_str[] = "1.2.3-rc.1+ci.build.20150223";
+    semver_t *p_semver = NULL;
+    char *p_str;
+    uint16_t str_len;
+
+    //Validation covers the parts that are not stored.
+    TEST_ASSERT_EQUAL(0, semver_parse_ex(semver_str, strlen(semver_str),
+                                         SEMVER_VALIDATE_ONLY, NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_parse_ex("1.2.3+b!d", 9,
+                                             SEMVER_SKIP_BMD, &p_semver));
+    TEST_ASSERT_NOT_EQUAL(0, semver_parse_ex(semver_str, strlen(semver_str), 0, NULL));
+
+    TEST_ASSERT_EQUAL(0, semver_parse_ex(semver_str, strlen(semver_str),
+                                         SEMVER_SKIP_BMD, &p_semver));
+    semver_get_bmd_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_NULL(p_str);
+    semver_get_pr_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("rc.1", p_str);
+    free(p_str);
+    semver_destroy(p_semver);
+
+    TEST_ASSERT_EQUAL(0, semver_parse_ex(semver_str, strlen(semver_str),
+                                         SEMVER_PRIMARY_ONLY, &p_semver));
+    TEST_ASSERT_EQUAL(3, semver_get_patch(p_semver));
+    semver_get_pr_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_NULL(p_str);
+    semver_destroy(p_semver);
+
+    //Borrowed text reads the same, and is copied before it is modified.
+    TEST_ASSERT_EQUAL(0, semver_parse_ex(semver_str, strlen(semver_str),
+                                         SEMVER_NO_COPY, &p_semver));
+    semver_get_bmd_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_PTR(semver_str + 11, p_str);
+    TEST_ASSERT_EQUAL(17, str_len);
+    TEST_ASSERT_EQUAL(0, semver_bump_prerelease(p_semver));
+    TEST_ASSERT_EQUAL_STRING("1.2.3-rc.1+ci.build.20150223", semver_str);
+    semver_get_pr_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("rc.2", p_str);
+    free(p_str);
+    semver_destroy(p_semver);
+}
+
+void test_semver_inline_tail(void)
+{
+    semver_t semver;
+    semver_t copy;
+    char *p_str;
+    int str_len;
+
+    semver_init(&semver);
+
+    //Typical tails stay inside the struct.
+    TEST_ASSERT_EQUAL(0, semver_parse_into(&semver, "1.0.0-rc.1+b.7", 14));
+    TEST_ASSERT_NULL(semver.tail);
+    TEST_ASSERT_EQUAL(0, semver_set_pr_str(&semver, "beta.2", 6));
+    TEST_ASSERT_EQUAL(0, semver_bump_prerelease(&semver));
+    TEST_ASSERT_NULL(semver.tail);
+
+    //...and being self-contained, can be copied by value.
+    copy = semver;
+    semver_to_str(&copy, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("1.0.0-beta.3", p_str);
+    free(p_str);
+
+    //Long ones spill to the heap, keeping what was there.
+    TEST_ASSERT_EQUAL(0, semver_set_bmd_str(&semver, "sha.5114f85a1b2c3d4e5f60718293a4b5c6", 36));
+    TEST_ASSERT_NOT_NULL(semver.tail);
+    semver_to_str(&semver, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("1.0.0-beta.3+sha.5114f85a1b2c3d4e5f60718293a4b5c6", p_str);
+    free(p_str);
+
+    semver_fini(&semver);
+}
+
+void test_semver_parse_into(void)
+{
+    semver_t *p_semver = NULL;
+    char *p_str;
+    char *p_tail;
+    int str_len;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_parse_into(NULL, "1.0.0", 5));
+    TEST_ASSERT_NOT_EQUAL(0, semver_reset(NULL));
+
+    semver_create(&p_semver);
+    TEST_ASSERT_NOT_EQUAL(0, semver_parse_into(p_semver, NULL, 5));
+
+    //Long enough to spill out of the inline buffer.
+    TEST_ASSERT_EQUAL(0, semver_parse_into(p_semver, "1.0.0-beta.11.x.y.z+build.7.0123456789abcdef", 44));
+    p_tail = p_semver->tail;
+    TEST_ASSERT_NOT_NULL(p_tail);
+
+    //Shorter tails land in the same buffer.
+    TEST_ASSERT_EQUAL(0, semver_parse_into(p_semver, "2.1.0-rc.1", 10));
+    TEST_ASSERT_EQUAL_PTR(p_tail, p_semver->tail);
+    semver_to_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("2.1.0-rc.1", p_str);
+    free(p_str);
+
+    //Invalid input leaves the semver alone.
+    TEST_ASSERT_TRUE(semver_parse_into(p_semver, "2.1", 3) > 0);
+    TEST_ASSERT_EQUAL(1, semver_get_minor(p_semver));
+
+    //Parsing text the semver itself holds ("1.2.3" is a valid pre-release).
+    TEST_ASSERT_EQUAL(0, semver_parse_into(p_semver, "0.0.1-1.2.3", 11));
+    TEST_ASSERT_EQUAL(0, semver_parse_into(p_semver, p_semver->tail, 5));
+    semver_to_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("1.2.3", p_str);
+    free(p_str);
+
+    semver_reset(p_semver);
+    semver_fini(p_semver);
+    TEST_ASSERT_EQUAL(0, semver_parse_into(p_semver, "0.0.1-1.2.3", 11));
+    TEST_ASSERT_EQUAL(0, semver_parse_into(p_semver, p_semver->inline_tail, 5));
+    semver_to_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("1.2.3", p_str);
+    free(p_str);
+
+    TEST_ASSERT_EQUAL(0, semver_reset(p_semver));
+    semver_to_str(p_semver, &p_str, &str_len);
+    TEST_ASSERT_EQUAL_STRING("0.0.0", p_str);
+    free(p_str);
+
+    semver_destroy(p_semver);
+}
+
+void test_semver_bump(void)
+{
+    char semver_str[] = "1.2.3-rc.9+build.7";
+    semver_t *p_semver;
+    char *p_out_str;
+    int out_str_len;
+
+    //Test for NULL param failures
+    TEST_ASSERT_NOT_EQUAL(0, semver_bump_major(NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_bump_minor(NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_bump_patch(NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_bump_prerelease(NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_finalize(NULL));
+
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver(semver_str, strlen(semver_str), &p_semver));
+
+    //rc.9 -> rc.10 grows the identifier, and drops the build meta-data.
+    TEST_ASSERT_EQUAL(0, semver_bump_prerelease(p_semver));
+    semver_to_str(p_semver, &p_out_str, &out_str_len);
+    TEST_ASSERT_EQUAL_STRING("1.2.3-rc.10", p_out_str);
+    free(p_out_str);
+
+    TEST_ASSERT_EQUAL(0, semver_bump_prerelease(p_semver));
+    semver_to_str(p_semver, &p_out_str, &out_str_len);
+    TEST_ASSERT_EQUAL_STRING("1.2.3-rc.11", p_out_str);
+    free(p_out_str);
+
+    //The patch bump of a pre-release is its release.
+    TEST_ASSERT_EQUAL(0, semver_bump_patch(p_semver));
+    semver_to_str(p_semver, &p_out_str, &out_str_len);
+    TEST_ASSERT_EQUAL_STRING("1.2.3", p_out_str);
+    free(p_out_str);
+
+    //Nothing left to bump.
+    TEST_ASSERT_NOT_EQUAL(0, semver_bump_prerelease(p_semver));
+
+    TEST_ASSERT_EQUAL(0, semver_bump_patch(p_semver));
+    TEST_ASSERT_EQUAL(4, semver_get_patch(p_semver));
+    TEST_ASSERT_EQUAL(0, semver_bump_minor(p_semver));
+    TEST_ASSERT_EQUAL(3, semver_get_minor(p_semver));
+    TEST_ASSERT_EQUAL(0, semver_get_patch(p_semver));
+    TEST_ASSERT_EQUAL(0, semver_bump_major(p_semver));
+    TEST_ASSERT_EQUAL(2, semver_get_major(p_semver));
+    TEST_ASSERT_EQUAL(0, semver_get_minor(p_semver));
+
+    //Non-numeric identifiers start counting from zero.
+    TEST_ASSERT_EQUAL(0, semver_set_pr_str(p_semver, "alpha", 5));
+    TEST_ASSERT_EQUAL(0, semver_bump_prerelease(p_semver));
+    semver_to_str(p_semver, &p_out_str, &out_str_len);
+    TEST_ASSERT_EQUAL_STRING("2.0.0-alpha.0", p_out_str);
+    free(p_out_str);
+
+    //2.0.0-alpha.0 already is the next major release's pre-release.
+    TEST_ASSERT_EQUAL(0, semver_bump_major(p_semver));
+    semver_to_str(p_semver, &p_out_str, &out_str_len);
+    TEST_ASSERT_EQUAL_STRING("2.0.0", p_out_str);
+    free(p_out_str);
+
+    TEST_ASSERT_EQUAL(0, semver_set_major(p_semver, UINT32_MAX));
+    TEST_ASSERT_NOT_EQUAL(0, semver_bump_major(p_semver));
+
+    semver_destroy(p_semver);
+}
+
 /******************************************************************************
  * static function definitions
  ******************************************************************************/
+
+static void* frozen_thread(void *p_arg)
+{
+    const semver_t **frozen = (const semver_t**)p_arg;
+    int result;
+    int i;
+
+    for(i=0;i<10000;i++)
+    {
+        semver_compare(frozen[1], frozen[0], &result);
+        TEST_ASSERT_EQUAL(-1, result);
+        semver_unref(semver_ref(frozen[i & 1]));
+    }
+
+    semver_unref(frozen[0]);
+    semver_unref(frozen[1]);
+    return NULL;
+}
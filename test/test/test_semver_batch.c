@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_batch.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define NUM_GENERATED 50000
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static semver_batch_t *g_p_batch = NULL;
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    g_p_batch = NULL;
+}
+
+void tearDown(void)
+{
+    if(NULL != g_p_batch)
+    {
+        semver_batch_destroy(g_p_batch);
+    }
+}
+
+void test_semver_batch_parse_null_params(void)
+{
+    TEST_ASSERT_NOT_EQUAL(0, semver_batch_parse(NULL, 0, &g_p_batch));
+    TEST_ASSERT_NOT_EQUAL(0, semver_batch_parse("1.0.0", 5, NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_batch_destroy(NULL));
+}
+
+void test_semver_batch_parse_columns(void)
+{
+    char buf[] = "1.2.3\n"
+                 "4.5.6-rc.1+build.7\r\n"
+                 "not.a.version\n"
+                 "\n"
+                 "7.8.9+sha.5114f85\n";
+
+    TEST_ASSERT_EQUAL(0, semver_batch_parse(buf, strlen(buf), &g_p_batch));
+    TEST_ASSERT_EQUAL(5, g_p_batch->count);
+
+    TEST_ASSERT_EQUAL(0, g_p_batch->status[0]);
+    TEST_ASSERT_EQUAL(1, g_p_batch->major[0]);
+    TEST_ASSERT_EQUAL(2, g_p_batch->minor[0]);
+    TEST_ASSERT_EQUAL(3, g_p_batch->patch[0]);
+    TEST_ASSERT_EQUAL(0, g_p_batch->pr_len[0]);
+    TEST_ASSERT_EQUAL(0, g_p_batch->bmd_len[0]);
+
+    //CRLF line, both tail components present.
+    TEST_ASSERT_EQUAL(0, g_p_batch->status[1]);
+    TEST_ASSERT_EQUAL(4, g_p_batch->major[1]);
+    TEST_ASSERT_EQUAL(18, g_p_batch->line_len[1]);
+    TEST_ASSERT_EQUAL_MEMORY("rc.1",
+                             buf + g_p_batch->line_off[1] + g_p_batch->pr_off[1],
+                             g_p_batch->pr_len[1]);
+    TEST_ASSERT_EQUAL_MEMORY("build.7",
+                             buf + g_p_batch->line_off[1] + g_p_batch->bmd_off[1],
+                             g_p_batch->bmd_len[1]);
+
+    //Invalid and empty lines keep their slots.
+    TEST_ASSERT_NOT_EQUAL(0, g_p_batch->status[2]);
+    TEST_ASSERT_NOT_EQUAL(0, g_p_batch->status[3]);
+
+    TEST_ASSERT_EQUAL(0, g_p_batch->status[4]);
+    TEST_ASSERT_EQUAL(9, g_p_batch->patch[4]);
+}
+
+void test_semver_batch_parse_unterminated_last_line(void)
+{
+    char buf[] = "1.0.0\n2.0.0-alpha";
+
+    TEST_ASSERT_EQUAL(0, semver_batch_parse(buf, strlen(buf), &g_p_batch));
+    TEST_ASSERT_EQUAL(2, g_p_batch->count);
+    TEST_ASSERT_EQUAL(0, g_p_batch->status[1]);
+    TEST_ASSERT_EQUAL(2, g_p_batch->major[1]);
+    TEST_ASSERT_EQUAL(5, g_p_batch->pr_len[1]);
+}
+
+void test_semver_batch_parse_parallel_preserves_order(void)
+{
+    semver_batch_t *p_serial = NULL;
+    char *buf;
+    size_t len = 0;
+    size_t i;
+
+    buf = (char*)malloc(NUM_GENERATED * 32);
+    TEST_ASSERT_NOT_NULL(buf);
+
+    for(i=0;i<NUM_GENERATED;i++)
+    {
+        len += sprintf(buf + len,
+                       (i % 3)? "%u.%u.%u\n" : "%u.%u.%u-rc.1\n",
+                       (unsigned)(i / 1000), (unsigned)(i % 1000), (unsigned)i);
+    }
+
+    TEST_ASSERT_EQUAL(0, semver_batch_parse(buf, len, &p_serial));
+    TEST_ASSERT_EQUAL(0, semver_batch_parse_parallel(buf, len, 4, &g_p_batch));
+
+    TEST_ASSERT_EQUAL(NUM_GENERATED, g_p_batch->count);
+    TEST_ASSERT_EQUAL(p_serial->count, g_p_batch->count);
+
+    for(i=0;i<NUM_GENERATED;i++)
+    {
+        TEST_ASSERT_EQUAL(0, g_p_batch->status[i]);
+        TEST_ASSERT_EQUAL(i, g_p_batch->patch[i]);
+        TEST_ASSERT_EQUAL(p_serial->line_off[i], g_p_batch->line_off[i]);
+        TEST_ASSERT_EQUAL(p_serial->pr_len[i], g_p_batch->pr_len[i]);
+    }
+
+    semver_batch_destroy(p_serial);
+    free(buf);
+}
@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_cache.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define NUM_THREADS 4
+#define NUM_LOOKUPS 2000
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static semver_cache_t *g_p_cache = NULL;
+
+static char *g_thread_strings[] =
+{
+    "1.0.0",
+    "1.0.0-rc.1",
+    "2.3.4-beta.2+build.7",
+    "10.20.30+sha.5114f85",
+};
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void* lookup_thread(void *p_arg);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    g_p_cache = NULL;
+}
+
+void tearDown(void)
+{
+    if(NULL != g_p_cache)
+    {
+        semver_cache_destroy(g_p_cache);
+    }
+}
+
+void test_semver_cache_create_destroy(void)
+{
+    TEST_ASSERT_NOT_EQUAL(0, semver_cache_create(NULL, 16));
+    TEST_ASSERT_NOT_EQUAL(0, semver_cache_create(&g_p_cache, 0));
+
+    TEST_ASSERT_EQUAL(0, semver_cache_create(&g_p_cache, 16));
+    TEST_ASSERT_NOT_EQUAL(NULL, g_p_cache);
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_cache_destroy(NULL));
+}
+
+void test_semver_cache_interns_equal_strings(void)
+{
+    char semver_str[] = "5.4.3-rc.3.2.1+sha.5114f85";
+    const semver_t *p_first = NULL;
+    const semver_t *p_second = NULL;
+    char *p_out_str = NULL;
+    int out_str_len = 0;
+    semver_cache_stats_t stats;
+
+    semver_cache_create(&g_p_cache, 16);
+
+    //Test NULL params
+    TEST_ASSERT_NOT_EQUAL(0, semver_cache_get(NULL, semver_str, strlen(semver_str), &p_first));
+    TEST_ASSERT_NOT_EQUAL(0, semver_cache_get(g_p_cache, NULL, 0, &p_first));
+    TEST_ASSERT_NOT_EQUAL(0, semver_cache_get(g_p_cache, semver_str, strlen(semver_str), NULL));
+
+    TEST_ASSERT_EQUAL(0, semver_cache_get(g_p_cache, semver_str, strlen(semver_str), &p_first));
+    TEST_ASSERT_EQUAL(0, semver_cache_get(g_p_cache, semver_str, strlen(semver_str), &p_second));
+
+    //Both lookups share the one canonical version.
+    TEST_ASSERT_EQUAL_PTR(p_first, p_second);
+    TEST_ASSERT_EQUAL(0, semver_to_str(p_first, &p_out_str, &out_str_len));
+    TEST_ASSERT_EQUAL_STRING(semver_str, p_out_str);
+    free(p_out_str);
+
+    TEST_ASSERT_EQUAL(0, semver_cache_get_stats(g_p_cache, &stats));
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+    TEST_ASSERT_EQUAL(1, stats.num_entries);
+
+    TEST_ASSERT_EQUAL(0, semver_cache_release(g_p_cache, p_first));
+    TEST_ASSERT_EQUAL(0, semver_cache_release(g_p_cache, p_second));
+}
+
+void test_semver_cache_rejects_invalid_strings(void)
+{
+    char invalid_str[] = "1.0.0+build-acbe.";
+    const semver_t *p_semver = NULL;
+    semver_cache_stats_t stats;
+
+    semver_cache_create(&g_p_cache, 16);
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_cache_get(g_p_cache, invalid_str, strlen(invalid_str), &p_semver));
+
+    semver_cache_get_stats(g_p_cache, &stats);
+    TEST_ASSERT_EQUAL(0, stats.num_entries);
+}
+
+void test_semver_cache_eviction_keeps_handles_alive(void)
+{
+    char semver_str[16];
+    const semver_t *p_held = NULL;
+    const semver_t *p_semver = NULL;
+    semver_cache_stats_t stats;
+    int i;
+
+    //One entry per shard.
+    semver_cache_create(&g_p_cache, SEMVER_CACHE_NUM_SHARDS);
+
+    TEST_ASSERT_EQUAL(0, semver_cache_get(g_p_cache, "9.9.9", 5, &p_held));
+
+    for(i=0;i<20*SEMVER_CACHE_NUM_SHARDS;i++)
+    {
+        snprintf(semver_str, sizeof(semver_str), "1.%d.0", i);
+        TEST_ASSERT_EQUAL(0, semver_cache_get(g_p_cache, semver_str, strlen(semver_str), &p_semver));
+        semver_cache_release(g_p_cache, p_semver);
+    }
+
+    semver_cache_get_stats(g_p_cache, &stats);
+    TEST_ASSERT_TRUE(stats.evictions > 0);
+    TEST_ASSERT_TRUE(stats.num_entries <= SEMVER_CACHE_NUM_SHARDS);
+
+    //Evicted or not, the handle we still hold must be intact.
+    TEST_ASSERT_EQUAL(9, semver_get_major(p_held));
+    TEST_ASSERT_EQUAL(9, semver_get_patch(p_held));
+    semver_cache_release(g_p_cache, p_held);
+}
+
+void test_semver_cache_handles_are_frozen(void)
+{
+    const char* semver_str = "1.2.3-rc.1+build.with-text-too-long-to-fit-inline";
+    const semver_t *p_semver = NULL;
+    const semver_t *p_again = NULL;
+    char *p_str;
+    int len;
+
+    semver_cache_create(&g_p_cache, 16);
+    TEST_ASSERT_EQUAL(0, semver_cache_get(g_p_cache, semver_str, strlen(semver_str), &p_semver));
+
+    //The usual frozen semver calls apply, in any mix with the cache's own.
+    TEST_ASSERT_EQUAL_PTR(p_semver, semver_ref(p_semver));
+    TEST_ASSERT_EQUAL(0, semver_unref(p_semver));
+    TEST_ASSERT_EQUAL(0, semver_cache_get(g_p_cache, semver_str, strlen(semver_str), &p_again));
+    TEST_ASSERT_EQUAL_PTR(p_semver, p_again);
+    TEST_ASSERT_EQUAL(0, semver_cache_release(g_p_cache, p_again));
+
+    //A handle outlives the cache.
+    semver_cache_destroy(g_p_cache);
+    g_p_cache = NULL;
+
+    TEST_ASSERT_EQUAL(0, semver_to_str(p_semver, &p_str, &len));
+    TEST_ASSERT_EQUAL_STRING(semver_str, p_str);
+    free(p_str);
+    TEST_ASSERT_EQUAL(0, semver_unref(p_semver));
+}
+
+void test_semver_cache_concurrent_lookups(void)
+{
+    pthread_t threads[NUM_THREADS];
+    semver_cache_stats_t stats;
+    int i;
+
+    semver_cache_create(&g_p_cache, 64);
+
+    for(i=0;i<NUM_THREADS;i++)
+    {
+        pthread_create(&threads[i], NULL, lookup_thread, NULL);
+    }
+    for(i=0;i<NUM_THREADS;i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    semver_cache_get_stats(g_p_cache, &stats);
+    TEST_ASSERT_EQUAL(NUM_THREADS*NUM_LOOKUPS, stats.hits + stats.misses);
+    TEST_ASSERT_EQUAL(sizeof(g_thread_strings)/sizeof(char*), stats.num_entries);
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static void* lookup_thread(void *p_arg)
+{
+    const semver_t *p_semver;
+    const char *semver_str;
+    int i;
+
+    (void)p_arg;
+
+    for(i=0;i<NUM_LOOKUPS;i++)
+    {
+        semver_str = g_thread_strings[i % (sizeof(g_thread_strings)/sizeof(char*))];
+        if(0 == semver_cache_get(g_p_cache, semver_str, strlen(semver_str), &p_semver))
+        {
+            semver_cache_release(g_p_cache, p_semver);
+        }
+    }
+
+    return NULL;
+}
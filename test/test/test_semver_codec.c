@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_codec.h"
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static char *g_round_trip_strings[] =
+{
+    "1.2.3",
+    "0.0.0",
+    "4294967295.1.0",
+    "1.0.0-rc.1",
+    "1.0.0-0.3.7",
+    "1.0.0-x.7.z.92",
+    "1.0.0-alpha.0.18446744073709551616",
+    "1.0.0-rc.1+build.1-b",
+    "1.3.7+build.11.e0f9-85a",
+    "2.0.0-alpha.123.abc+build.acebfde1284",
+};
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static semver_t* parse(const char* semver_str);
+static void assert_semver_str(const char* expected, const semver_t *p_semver);
+static int decode_text_pr(const char* id);
+static int decode_bmd(const char* bmd_str);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_semver_encode_null_params(void)
+{
+    semver_t *p_semver = parse("1.2.3");
+    uint8_t buf[32];
+    size_t written;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_encode(NULL, buf, sizeof(buf), &written));
+    TEST_ASSERT_NOT_EQUAL(0, semver_encode(p_semver, NULL, sizeof(buf), &written));
+    TEST_ASSERT_NOT_EQUAL(0, semver_encode(p_semver, buf, sizeof(buf), NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_decode(NULL, 0, &p_semver, &written));
+
+    //Too small a buffer is an error, not a truncation.
+    TEST_ASSERT_NOT_EQUAL(0, semver_encode(p_semver, buf, 3, &written));
+
+    semver_destroy(p_semver);
+}
+
+void test_semver_encode_is_compact(void)
+{
+    semver_t *p_semver;
+    uint8_t buf[32];
+    size_t written;
+    size_t size;
+
+    p_semver = parse("1.2.3");
+    TEST_ASSERT_EQUAL(0, semver_encode(p_semver, buf, sizeof(buf), &written));
+    TEST_ASSERT_EQUAL(4, written);
+    semver_destroy(p_semver);
+
+    p_semver = parse("1.2.3-rc.1");
+    TEST_ASSERT_EQUAL(0, semver_encoded_size(p_semver, &size));
+    TEST_ASSERT_EQUAL(0, semver_encode(p_semver, buf, sizeof(buf), &written));
+    TEST_ASSERT_EQUAL(8, written);
+    TEST_ASSERT_EQUAL(size, written);
+    semver_destroy(p_semver);
+}
+
+void test_semver_encode_decode_round_trip(void)
+{
+    semver_t *p_semver;
+    semver_t *p_decoded;
+    uint8_t buf[128];
+    size_t written;
+    size_t read;
+    int i;
+
+    for(i=0;i<sizeof(g_round_trip_strings)/sizeof(char*);i++)
+    {
+        p_semver = parse(g_round_trip_strings[i]);
+
+        TEST_ASSERT_EQUAL(0, semver_encode(p_semver, buf, sizeof(buf), &written));
+        TEST_ASSERT_EQUAL(0, semver_decode(buf, written, &p_decoded, &read));
+        TEST_ASSERT_EQUAL(written, read);
+        assert_semver_str(g_round_trip_strings[i], p_decoded);
+
+        //Every truncation of a valid encoding must be rejected.
+        while(written--)
+        {
+            TEST_ASSERT_NOT_EQUAL(0, semver_decode(buf, written, &p_decoded, &read));
+        }
+
+        semver_destroy(p_decoded);
+        semver_destroy(p_semver);
+    }
+}
+
+void test_semver_decode_rejects_bad_identifiers(void)
+{
+    //1.2.3 with one two byte alphanumeric identifier "r!"
+    uint8_t buf[] = { 1, 2, 3, 2, 5, 'r', '!' };
+    semver_t *p_semver;
+    size_t read;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_decode(buf, sizeof(buf), &p_semver, &read));
+
+    buf[6] = 'c';
+    TEST_ASSERT_EQUAL(0, semver_decode(buf, sizeof(buf), &p_semver, &read));
+    assert_semver_str("1.2.3-rc", p_semver);
+    semver_destroy(p_semver);
+
+    //Numbers sent as text: not canonical ("0", which has a numeric tag) or
+    //not valid at all ("007"). Only numbers too large for a tag may be.
+    TEST_ASSERT_NOT_EQUAL(0, decode_text_pr("0"));
+    TEST_ASSERT_NOT_EQUAL(0, decode_text_pr("007"));
+    TEST_ASSERT_NOT_EQUAL(0, decode_text_pr("9223372036854775807"));
+    TEST_ASSERT_EQUAL(0, decode_text_pr("9223372036854775808"));
+    TEST_ASSERT_EQUAL(0, decode_text_pr("0a7"));
+
+    //Build meta-data with an empty identifier.
+    TEST_ASSERT_NOT_EQUAL(0, decode_bmd("."));
+    TEST_ASSERT_NOT_EQUAL(0, decode_bmd("a..b"));
+    TEST_ASSERT_NOT_EQUAL(0, decode_bmd(".a"));
+    TEST_ASSERT_NOT_EQUAL(0, decode_bmd("a."));
+    TEST_ASSERT_NOT_EQUAL(0, decode_bmd("a+b"));
+    TEST_ASSERT_EQUAL(0, decode_bmd("a.b-7.c"));
+}
+
+void test_semver_encode_decode_many(void)
+{
+    semver_t *semvers[sizeof(g_round_trip_strings)/sizeof(char*)];
+    semver_t *decoded[sizeof(g_round_trip_strings)/sizeof(char*)];
+    size_t num_semvers = sizeof(g_round_trip_strings)/sizeof(char*);
+    uint8_t buf[512];
+    size_t written;
+    size_t read;
+    size_t i;
+
+    for(i=0;i<num_semvers;i++)
+    {
+        semvers[i] = parse(g_round_trip_strings[i]);
+    }
+
+    TEST_ASSERT_EQUAL(0, semver_encode_many((const semver_t *const *)semvers,
+                                            num_semvers, buf, sizeof(buf), &written));
+    TEST_ASSERT_EQUAL(0, semver_decode_many(buf, written, decoded, num_semvers, &read));
+    TEST_ASSERT_EQUAL(written, read);
+
+    for(i=0;i<num_semvers;i++)
+    {
+        assert_semver_str(g_round_trip_strings[i], decoded[i]);
+        semver_destroy(decoded[i]);
+        semver_destroy(semvers[i]);
+    }
+
+    //Asking for one more than was encoded fails as a whole.
+    TEST_ASSERT_NOT_EQUAL(0, semver_decode_many(buf, 4, decoded, 2, &read));
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static semver_t* parse(const char* semver_str)
+{
+    semver_t *p_semver = NULL;
+
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver(semver_str, strlen(semver_str), &p_semver));
+    return p_semver;
+}
+
+static void assert_semver_str(const char* expected, const semver_t *p_semver)
+{
+    char *p_str = NULL;
+    int str_len;
+
+    TEST_ASSERT_EQUAL(0, semver_to_str(p_semver, &p_str, &str_len));
+    TEST_ASSERT_EQUAL_STRING(expected, p_str);
+    free(p_str);
+}
+
+//Decodes 1.2.3 with the given build meta-data and no pre-release.
+static int decode_bmd(const char* bmd_str)
+{
+    uint8_t buf[32] = { 1, 2, 3, 1 };
+    char expected[40];
+    semver_t *p_semver;
+    size_t len = strlen(bmd_str);
+    size_t read;
+    int result;
+
+    buf[4] = (uint8_t)len;
+    memcpy(&buf[5], bmd_str, len);
+
+    result = semver_decode(buf, 5 + len, &p_semver, &read);
+    if(0 == result)
+    {
+        snprintf(expected, sizeof(expected), "1.2.3+%s", bmd_str);
+        assert_semver_str(expected, p_semver);
+        semver_destroy(p_semver);
+    }
+
+    return result;
+}
+
+//Decodes 1.2.3 with one pre-release identifier, sent as text.
+static int decode_text_pr(const char* id)
+{
+    uint8_t buf[32] = { 1, 2, 3, 2 };
+    char expected[40];
+    semver_t *p_semver;
+    size_t len = strlen(id);
+    size_t read;
+    int result;
+
+    buf[4] = (uint8_t)((len << 1) | 1);
+    memcpy(&buf[5], id, len);
+
+    result = semver_decode(buf, 5 + len, &p_semver, &read);
+    if(0 == result)
+    {
+        snprintf(expected, sizeof(expected), "1.2.3-%s", id);
+        assert_semver_str(expected, p_semver);
+        semver_destroy(p_semver);
+    }
+
+    return result;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_extract.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define MAX_MATCHES 16
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef struct found_
+{
+    const char* buf;
+    int count;
+    int stop_after;
+    char matches[MAX_MATCHES][64];
+    char parsed[MAX_MATCHES][64];
+} found_t;
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static found_t g_found;
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static int collect(void *p_ctx, const semver_match_t *p_match);
+static void extract(const char* text, uint32_t flags);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    memset(&g_found, 0, sizeof(g_found));
+}
+
+void tearDown(void) {}
+
+void test_semver_extract_null_params(void)
+{
+    TEST_ASSERT_TRUE(semver_extract(NULL, 0, 0, collect, &g_found) < 0);
+    TEST_ASSERT_TRUE(semver_extract("1.2.3", 5, 0, NULL, &g_found) < 0);
+    TEST_ASSERT_EQUAL(0, semver_extract("", 0, 0, collect, &g_found));
+    TEST_ASSERT_EQUAL(0, g_found.count);
+}
+
+void test_semver_extract_log_line(void)
+{
+    extract("[INFO] upgraded libfoo from v1.2.3 to 2.0.0-rc.1+b.7; zlib 1.2 kept. "
+            "1.2.3.4 is not one, and neither is 01.2.3 nor 1.x.3", 0);
+
+    TEST_ASSERT_EQUAL(3, g_found.count);
+    TEST_ASSERT_EQUAL_STRING("1.2.3", g_found.matches[0]);
+    TEST_ASSERT_EQUAL_STRING("2.0.0-rc.1+b.7", g_found.matches[1]);
+    TEST_ASSERT_EQUAL_STRING("1.2.3", g_found.matches[2]);
+}
+
+void test_semver_extract_file_names(void)
+{
+    extract("pkg-1.2.3-rc.1.tar.gz libbar_10.0.1.zip", 0);
+
+    TEST_ASSERT_EQUAL(2, g_found.count);
+    TEST_ASSERT_EQUAL_STRING("1.2.3-rc.1.tar.gz", g_found.matches[0]);
+    TEST_ASSERT_EQUAL_STRING("10.0.1", g_found.matches[1]);
+}
+
+void test_semver_extract_longest_valid(void)
+{
+    //The longest run the grammar accepts fails the leading zero and range
+    //checks. A shorter prefix would end mid-number, so nothing is reported.
+    extract("1.2.3-a.01 v1.2.00 1.2.999999999999 99999999999.1.2 1.2.3rc1 "
+            "3.4.5-0.1.02x", 0);
+
+    TEST_ASSERT_EQUAL(1, g_found.count);
+    TEST_ASSERT_EQUAL_STRING("3.4.5-0.1.02x", g_found.matches[0]);
+
+    //A separator ends a match cleanly.
+    setUp();
+    extract("1.2.3-rc.1_final 4.5.6,7.8.9", 0);
+    TEST_ASSERT_EQUAL(3, g_found.count);
+    TEST_ASSERT_EQUAL_STRING("1.2.3-rc.1", g_found.matches[0]);
+    TEST_ASSERT_EQUAL_STRING("4.5.6", g_found.matches[1]);
+    TEST_ASSERT_EQUAL_STRING("7.8.9", g_found.matches[2]);
+
+    //A NUL ends one too.
+    setUp();
+    g_found.buf = "1.2.3\0-rc.1";
+    TEST_ASSERT_EQUAL(0, semver_extract(g_found.buf, 11, 0, collect, &g_found));
+    TEST_ASSERT_EQUAL(1, g_found.count);
+    TEST_ASSERT_EQUAL_STRING("1.2.3", g_found.matches[0]);
+}
+
+void test_semver_extract_parse_and_stop(void)
+{
+    static const char text[] = "a 1.0.0-alpha.1+sha.5114f85 b 2.3.4 c 5.6.7";
+
+    extract(text, SEMVER_EXTRACT_PARSE);
+    TEST_ASSERT_EQUAL(3, g_found.count);
+    TEST_ASSERT_EQUAL_STRING(g_found.matches[0], g_found.parsed[0]);
+    TEST_ASSERT_EQUAL_STRING(g_found.matches[1], g_found.parsed[1]);
+
+    setUp();
+    g_found.buf = text;
+    g_found.stop_after = 2;
+    TEST_ASSERT_TRUE(semver_extract(text, strlen(text), 0, collect, &g_found) > 0);
+    TEST_ASSERT_EQUAL(2, g_found.count);
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static int collect(void *p_ctx, const semver_match_t *p_match)
+{
+    found_t *p_found = (found_t*)p_ctx;
+    char *p_str;
+    int str_len;
+
+    TEST_ASSERT_TRUE(p_found->count < MAX_MATCHES);
+    TEST_ASSERT_TRUE(p_match->len < sizeof(p_found->matches[0]));
+
+    memcpy(p_found->matches[p_found->count], p_found->buf + p_match->off, p_match->len);
+    p_found->matches[p_found->count][p_match->len] = '\0';
+
+    if(NULL != p_match->p_semver)
+    {
+        TEST_ASSERT_EQUAL(0, semver_to_str(p_match->p_semver, &p_str, &str_len));
+        snprintf(p_found->parsed[p_found->count], sizeof(p_found->parsed[0]), "%s", p_str);
+        free(p_str);
+    }
+
+    p_found->count++;
+    return p_found->stop_after == p_found->count;
+}
+
+static void extract(const char* text, uint32_t flags)
+{
+    g_found.buf = text;
+    TEST_ASSERT_EQUAL(0, semver_extract(text, strlen(text), flags, collect, &g_found));
+}
@@ -0,0 +1,240 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_batch.h"
+#include "semver_filter.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define NUM_RANDOM_ROWS 1000
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static semver_batch_t *g_p_batch = NULL;
+static semver_t *g_p_lo = NULL;
+static semver_t *g_p_hi = NULL;
+
+static const char* g_pr_strs[] = { "", "", "-alpha", "-alpha.1", "-rc.1", "-rc.11" };
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static semver_t* parse(const char* semver_str);
+static bool in_interval(const semver_t *p_semver,
+                        const semver_t *p_lo,
+                        const semver_t *p_hi,
+                        uint32_t flags);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    g_p_batch = NULL;
+    g_p_lo = NULL;
+    g_p_hi = NULL;
+}
+
+void tearDown(void)
+{
+    if(NULL != g_p_batch)
+    {
+        semver_batch_destroy(g_p_batch);
+    }
+    semver_destroy(g_p_lo);
+    semver_destroy(g_p_hi);
+}
+
+void test_semver_filter_null_params(void)
+{
+    semver_interval_t interval;
+    uint64_t mask;
+    size_t rows[1];
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_interval_compile(NULL, NULL, NULL, 0));
+    TEST_ASSERT_EQUAL(0, semver_interval_compile(&interval, NULL, NULL, 0));
+
+    TEST_ASSERT_EQUAL(0, semver_batch_parse("1.0.0", 5, &g_p_batch));
+    TEST_ASSERT_NOT_EQUAL(0, semver_batch_filter(NULL, "1.0.0", &interval, &mask, NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_batch_filter(g_p_batch, NULL, &interval, &mask, NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_batch_filter(g_p_batch, "1.0.0", NULL, &mask, NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_batch_filter(g_p_batch, "1.0.0", &interval, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, semver_mask_to_rows(NULL, 1, rows));
+}
+
+void test_semver_filter_half_open_range(void)
+{
+    char buf[] = "4.1.9\n"
+                 "4.2.0-rc.1\n"
+                 "4.2.0\n"
+                 "4.10.3+build.7\n"
+                 "5.0.0-alpha\n"
+                 "5.0.0\n"
+                 "not.a.version\n"
+                 "4.3.0\n";
+    semver_interval_t interval;
+    uint64_t mask = 0;
+    size_t rows[8];
+    size_t num_matches = 0;
+
+    //>=4.2.0 <5.0.0, where 5.0.0-alpha is below 5.0.0.
+    TEST_ASSERT_EQUAL(0, semver_batch_parse(buf, strlen(buf), &g_p_batch));
+    g_p_lo = parse("4.2.0");
+    g_p_hi = parse("5.0.0");
+    TEST_ASSERT_EQUAL(0, semver_interval_compile(&interval, g_p_lo, g_p_hi, 0));
+    TEST_ASSERT_EQUAL(0, semver_batch_filter(g_p_batch, buf, &interval, &mask, &num_matches));
+
+    TEST_ASSERT_EQUAL(4, num_matches);
+    TEST_ASSERT_EQUAL(4, semver_mask_to_rows(&mask, g_p_batch->count, rows));
+    TEST_ASSERT_EQUAL(2, rows[0]);
+    TEST_ASSERT_EQUAL(3, rows[1]);
+    TEST_ASSERT_EQUAL(4, rows[2]);
+    TEST_ASSERT_EQUAL(7, rows[3]);
+}
+
+void test_semver_filter_pivot_with_pre_release(void)
+{
+    char buf[] = "1.0.0-rc.1\n"
+                 "1.0.0-rc.2\n"
+                 "1.0.0-rc.1.1\n"
+                 "1.0.0\n"
+                 "1.0.0-beta\n";
+    semver_interval_t interval;
+    uint64_t mask = 0;
+    size_t num_matches = 0;
+
+    TEST_ASSERT_EQUAL(0, semver_batch_parse(buf, strlen(buf), &g_p_batch));
+    g_p_lo = parse("1.0.0-rc.1");
+
+    //> 1.0.0-rc.1
+    semver_interval_compile(&interval, g_p_lo, NULL, SEMVER_INTERVAL_LO_EXCLUSIVE);
+    TEST_ASSERT_EQUAL(0, semver_batch_filter(g_p_batch, buf, &interval, &mask, &num_matches));
+    TEST_ASSERT_EQUAL(3, num_matches);
+    TEST_ASSERT_EQUAL_HEX64(0xE, mask);
+
+    //== 1.0.0-rc.1
+    semver_interval_compile(&interval, g_p_lo, g_p_lo, SEMVER_INTERVAL_HI_INCLUSIVE);
+    TEST_ASSERT_EQUAL(0, semver_batch_filter(g_p_batch, buf, &interval, &mask, &num_matches));
+    TEST_ASSERT_EQUAL(1, num_matches);
+    TEST_ASSERT_EQUAL_HEX64(0x1, mask);
+}
+
+void test_semver_filter_matches_semver_compare(void)
+{
+    const char* bound_strs[] = { "1.1.1", "1.1.1-alpha.1", "0.2.0-rc.1", "2.0.0" };
+    char *buf;
+    size_t len = 0;
+    semver_t *rows[NUM_RANDOM_ROWS + 13];
+    uint64_t mask[SEMVER_MASK_WORDS(NUM_RANDOM_ROWS + 13)];
+    semver_interval_t interval;
+    size_t num_rows = NUM_RANDOM_ROWS + 13;
+    size_t num_matches;
+    size_t expected;
+    uint32_t flags;
+    size_t i;
+    int lo;
+    int hi;
+
+    buf = (char*)malloc(num_rows * 32);
+    srand(2015);
+    for(i=0;i<num_rows;i++)
+    {
+        int start = len;
+
+        if(0 == rand() % 16)
+        {
+            len += sprintf(buf + len, "1.1.01\n");
+        }
+        else
+        {
+            len += sprintf(buf + len, "%d.%d.%d%s\n", rand() % 3, rand() % 3, rand() % 3,
+                           g_pr_strs[rand() % (sizeof(g_pr_strs)/sizeof(char*))]);
+        }
+
+        rows[i] = NULL;
+        semver_str_to_semver(buf + start, len - start - 1, &rows[i]);
+    }
+    TEST_ASSERT_EQUAL(0, semver_batch_parse(buf, len, &g_p_batch));
+    TEST_ASSERT_EQUAL(num_rows, g_p_batch->count);
+
+    for(lo=-1;lo<4;lo++)
+    {
+        for(hi=-1;hi<4;hi++)
+        {
+            for(flags=0;flags<4;flags++)
+            {
+                semver_t *p_lo = (lo < 0)? NULL : parse(bound_strs[lo]);
+                semver_t *p_hi = (hi < 0)? NULL : parse(bound_strs[hi]);
+
+                semver_interval_compile(&interval, p_lo, p_hi, flags);
+                TEST_ASSERT_EQUAL(0, semver_batch_filter(g_p_batch, buf, &interval,
+                                                         mask, &num_matches));
+
+                expected = 0;
+                for(i=0;i<num_rows;i++)
+                {
+                    bool match = (NULL != rows[i] && in_interval(rows[i], p_lo, p_hi, flags));
+
+                    TEST_ASSERT_EQUAL(match, (mask[i / 64] >> (i % 64)) & 1);
+                    expected += match;
+                }
+                TEST_ASSERT_EQUAL(expected, num_matches);
+
+                semver_destroy(p_lo);
+                semver_destroy(p_hi);
+            }
+        }
+    }
+
+    for(i=0;i<num_rows;i++)
+    {
+        semver_destroy(rows[i]);
+    }
+    free(buf);
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static semver_t* parse(const char* semver_str)
+{
+    semver_t *p_semver = NULL;
+
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver(semver_str, strlen(semver_str), &p_semver));
+    return p_semver;
+}
+
+static bool in_interval(const semver_t *p_semver,
+                        const semver_t *p_lo,
+                        const semver_t *p_hi,
+                        uint32_t flags)
+{
+    int cmp;
+
+    if(NULL != p_lo)
+    {
+        semver_compare(p_semver, p_lo, &cmp);
+        if(cmp < 0 || (0 == cmp && 0 != (flags & SEMVER_INTERVAL_LO_EXCLUSIVE)))
+        {
+            return false;
+        }
+    }
+
+    if(NULL != p_hi)
+    {
+        semver_compare(p_semver, p_hi, &cmp);
+        if(cmp > 0 || (0 == cmp && 0 == (flags & SEMVER_INTERVAL_HI_INCLUSIVE)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
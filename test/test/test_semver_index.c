@@ -0,0 +1,288 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_index.h"
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef struct test_row_
+{
+    const char* pkg;
+    const char* version;
+} test_row_t;
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static test_row_t g_rows[] =
+{
+    { "zlib",   "1.2.11" },
+    { "libfoo", "2.0.0" },
+    { "libfoo", "1.0.0-rc.1" },
+    { "libfoo", "1.0.0" },
+    { "libfoo", "1.0.0-beta.11" },
+    { "libfoo", "1.0.0-beta.2" },
+    { "libfoo", "1.10.0+build.2" },
+    { "libfoo", "1.2.0" },
+    { "zlib",   "1.2.8" },
+    { "libfoo", "1.10.0+build.1" },
+};
+
+/* g_rows' libfoo versions, in precedence order. */
+static const char* g_sorted_libfoo[] =
+{
+    "1.0.0-beta.2",
+    "1.0.0-beta.11",
+    "1.0.0-rc.1",
+    "1.0.0",
+    "1.2.0",
+    "1.10.0",
+    "1.10.0",
+    "2.0.0",
+};
+
+static char g_path[] = "/tmp/test_semver_index_XXXXXX";
+static semver_t *g_semvers[sizeof(g_rows)/sizeof(test_row_t)];
+static semver_index_row_t g_index_rows[sizeof(g_rows)/sizeof(test_row_t)];
+static semver_index_t *g_p_index;
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static semver_t* parse(const char* semver_str);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    int fd;
+    int i;
+
+    strcpy(g_path, "/tmp/test_semver_index_XXXXXX");
+    fd = mkstemp(g_path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    for(i=0;i<sizeof(g_rows)/sizeof(test_row_t);i++)
+    {
+        g_semvers[i] = parse(g_rows[i].version);
+        g_index_rows[i].pkg = g_rows[i].pkg;
+        g_index_rows[i].pkg_len = strlen(g_rows[i].pkg);
+        g_index_rows[i].p_semver = g_semvers[i];
+    }
+
+    g_p_index = NULL;
+}
+
+void tearDown(void)
+{
+    int i;
+
+    if(NULL != g_p_index)
+    {
+        semver_index_close(g_p_index);
+    }
+
+    for(i=0;i<sizeof(g_rows)/sizeof(test_row_t);i++)
+    {
+        semver_destroy(g_semvers[i]);
+    }
+
+    unlink(g_path);
+}
+
+void test_semver_index_null_params(void)
+{
+    TEST_ASSERT_NOT_EQUAL(0, semver_index_write(NULL, g_index_rows, 1));
+    TEST_ASSERT_NOT_EQUAL(0, semver_index_write(g_path, NULL, 1));
+    TEST_ASSERT_NOT_EQUAL(0, semver_index_open(NULL, &g_p_index));
+    TEST_ASSERT_NOT_EQUAL(0, semver_index_open(g_path, NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_index_close(NULL));
+}
+
+void test_semver_index_rejects_foreign_files(void)
+{
+    FILE *p_file = fopen(g_path, "wb");
+
+    fputs("definitely not an index, but long enough to hold a header ......", p_file);
+    fclose(p_file);
+
+    TEST_ASSERT_TRUE(semver_index_open(g_path, &g_p_index) > 0);
+    g_p_index = NULL;
+}
+
+void test_semver_index_rows_are_sorted(void)
+{
+    semver_index_entry_t entry;
+    uint32_t i;
+
+    TEST_ASSERT_EQUAL(0, semver_index_write(g_path, g_index_rows,
+                                            sizeof(g_rows)/sizeof(test_row_t)));
+    TEST_ASSERT_EQUAL(0, semver_index_open(g_path, &g_p_index));
+    TEST_ASSERT_EQUAL(sizeof(g_rows)/sizeof(test_row_t), semver_index_num_rows(g_p_index));
+
+    for(i=0;i<sizeof(g_sorted_libfoo)/sizeof(char*);i++)
+    {
+        char version[32];
+
+        TEST_ASSERT_EQUAL(0, semver_index_get(g_p_index, i, &entry));
+        TEST_ASSERT_EQUAL_MEMORY("libfoo", entry.pkg, entry.pkg_len);
+
+        snprintf(version, sizeof(version), "%u.%u.%u%s%.*s",
+                 entry.major, entry.minor, entry.patch,
+                 entry.pr_str_len? "-" : "",
+                 entry.pr_str_len, entry.pr_str);
+        TEST_ASSERT_EQUAL_STRING(g_sorted_libfoo[i], version);
+    }
+
+    //Equal precedence keeps input order.
+    TEST_ASSERT_EQUAL(0, semver_index_get(g_p_index, 5, &entry));
+    TEST_ASSERT_EQUAL_MEMORY("build.2", entry.bmd_str, entry.bmd_str_len);
+
+    TEST_ASSERT_EQUAL(0, semver_index_get(g_p_index, i, &entry));
+    TEST_ASSERT_EQUAL_MEMORY("zlib", entry.pkg, entry.pkg_len);
+    TEST_ASSERT_EQUAL(8, entry.patch);
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_index_get(g_p_index, semver_index_num_rows(g_p_index), &entry));
+}
+
+void test_semver_index_lookup(void)
+{
+    semver_t *p_query;
+    uint32_t row;
+
+    semver_index_write(g_path, g_index_rows, sizeof(g_rows)/sizeof(test_row_t));
+    TEST_ASSERT_EQUAL(0, semver_index_open(g_path, &g_p_index));
+
+    p_query = parse("1.0.0-beta.11");
+    TEST_ASSERT_EQUAL(0, semver_index_lookup(g_p_index, "libfoo", 6, p_query, &row));
+    TEST_ASSERT_EQUAL(1, row);
+    TEST_ASSERT_TRUE(semver_index_lookup(g_p_index, "zlib", 4, p_query, &row) > 0);
+    TEST_ASSERT_TRUE(semver_index_lookup(g_p_index, "libbar", 6, p_query, &row) > 0);
+    semver_destroy(p_query);
+
+    p_query = parse("1.2.8");
+    TEST_ASSERT_EQUAL(0, semver_index_lookup(g_p_index, "zlib", 4, p_query, &row));
+    TEST_ASSERT_EQUAL(8, row);
+    semver_destroy(p_query);
+}
+
+void test_semver_index_range(void)
+{
+    semver_t *p_lo = parse("1.0.0");
+    semver_t *p_hi = parse("2.0.0");
+    uint32_t first;
+    uint32_t end;
+
+    semver_index_write(g_path, g_index_rows, sizeof(g_rows)/sizeof(test_row_t));
+    TEST_ASSERT_EQUAL(0, semver_index_open(g_path, &g_p_index));
+
+    //>=1.0.0 <2.0.0
+    TEST_ASSERT_EQUAL(0, semver_index_range(g_p_index, "libfoo", 6, p_lo, p_hi, &first, &end));
+    TEST_ASSERT_EQUAL(3, first);
+    TEST_ASSERT_EQUAL(7, end);
+
+    //<1.0.0 is only pre-releases.
+    TEST_ASSERT_EQUAL(0, semver_index_range(g_p_index, "libfoo", 6, NULL, p_lo, &first, &end));
+    TEST_ASSERT_EQUAL(0, first);
+    TEST_ASSERT_EQUAL(3, end);
+
+    //The whole package.
+    TEST_ASSERT_EQUAL(0, semver_index_range(g_p_index, "zlib", 4, NULL, NULL, &first, &end));
+    TEST_ASSERT_EQUAL(8, first);
+    TEST_ASSERT_EQUAL(10, end);
+
+    semver_destroy(p_lo);
+    semver_destroy(p_hi);
+}
+
+void test_semver_index_key_extremes(void)
+{
+    const char* versions[] = { "4294967295.0.0", "0.4294967295.4294967295",
+                               "1.0.4294967295-rc", "1.0.4294967295", "1.0.4294967295-beta" };
+    semver_index_row_t rows[5];
+    semver_t *semvers[5];
+    semver_index_entry_t entry;
+    uint32_t row;
+    int i;
+
+    for(i=0;i<5;i++)
+    {
+        semvers[i] = parse(versions[i]);
+        rows[i].pkg = "big";
+        rows[i].pkg_len = 3;
+        rows[i].p_semver = semvers[i];
+    }
+
+    TEST_ASSERT_EQUAL(0, semver_index_write(g_path, rows, 5));
+    TEST_ASSERT_EQUAL(0, semver_index_open(g_path, &g_p_index));
+
+    //Keys tie for all three 1.0.4294967295 rows; the pre-release text
+    //breaks it.
+    TEST_ASSERT_EQUAL(0, semver_index_get(g_p_index, 1, &entry));
+    TEST_ASSERT_EQUAL_MEMORY("beta", entry.pr_str, entry.pr_str_len);
+    TEST_ASSERT_EQUAL(0, semver_index_get(g_p_index, 4, &entry));
+    TEST_ASSERT_EQUAL(4294967295u, entry.major);
+    TEST_ASSERT_EQUAL(0, entry.minor);
+
+    for(i=0;i<5;i++)
+    {
+        TEST_ASSERT_EQUAL(0, semver_index_lookup(g_p_index, "big", 3, semvers[i], &row));
+        TEST_ASSERT_EQUAL(0, semver_index_get(g_p_index, row, &entry));
+        TEST_ASSERT_EQUAL(semvers[i]->patch, entry.patch);
+        TEST_ASSERT_EQUAL(semvers[i]->pr_len, entry.pr_str_len);
+        semver_destroy(semvers[i]);
+    }
+}
+
+void test_semver_index_rewrite_keeps_old_mapping(void)
+{
+    semver_index_t *p_new_index = NULL;
+    semver_index_entry_t entry;
+    uint32_t i;
+
+    TEST_ASSERT_EQUAL(0, semver_index_write(g_path, g_index_rows,
+                                            sizeof(g_rows)/sizeof(test_row_t)));
+    TEST_ASSERT_EQUAL(0, semver_index_open(g_path, &g_p_index));
+
+    //Reindex down to the first two rows while the old index is still mapped.
+    TEST_ASSERT_EQUAL(0, semver_index_write(g_path, g_index_rows, 2));
+    TEST_ASSERT_EQUAL(0, semver_index_open(g_path, &p_new_index));
+    TEST_ASSERT_EQUAL(2, semver_index_num_rows(p_new_index));
+
+    //The old mapping still reads every one of its rows.
+    TEST_ASSERT_EQUAL(sizeof(g_rows)/sizeof(test_row_t), semver_index_num_rows(g_p_index));
+    for(i=0;i<semver_index_num_rows(g_p_index);i++)
+    {
+        TEST_ASSERT_EQUAL(0, semver_index_get(g_p_index, i, &entry));
+    }
+    TEST_ASSERT_EQUAL_MEMORY("zlib", entry.pkg, entry.pkg_len);
+    TEST_ASSERT_EQUAL(11, entry.patch);
+
+    TEST_ASSERT_EQUAL(0, semver_index_get(p_new_index, 1, &entry));
+    TEST_ASSERT_EQUAL_MEMORY("zlib", entry.pkg, entry.pkg_len);
+
+    semver_index_close(p_new_index);
+
+    //Nowhere to put the temporary file.
+    TEST_ASSERT_NOT_EQUAL(0, semver_index_write("/nonexistent/dir/index", g_index_rows, 2));
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static semver_t* parse(const char* semver_str)
+{
+    semver_t *p_semver = NULL;
+
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver(semver_str, strlen(semver_str), &p_semver));
+    return p_semver;
+}
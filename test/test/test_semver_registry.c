@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_registry.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define NUM_THREADS  8
+#define NUM_PACKAGES 4
+#define NUM_VERSIONS 400
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static semver_registry_t *g_p_registry = NULL;
+static semver_t *g_versions[NUM_VERSIONS];
+
+static const char* g_packages[NUM_PACKAGES] = { "openssl", "zlib", "libc", "curl" };
+static const char* g_pr_strs[] = { "-alpha", "-beta.2", "-rc.1", "-rc.10", "" };
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static int report(const char* package, const char* semver_str);
+static void assert_latest(const char* package, const char* expected);
+static void* report_thread(void *p_arg);
+static void* latest_thread(void *p_arg);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    g_p_registry = NULL;
+}
+
+void tearDown(void)
+{
+    if(NULL != g_p_registry)
+    {
+        semver_registry_destroy(g_p_registry);
+    }
+}
+
+void test_semver_registry_create_destroy(void)
+{
+    const semver_t *p_latest;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_registry_create(NULL, 16));
+    TEST_ASSERT_NOT_EQUAL(0, semver_registry_create(&g_p_registry, 0));
+    TEST_ASSERT_NOT_EQUAL(0, semver_registry_destroy(NULL));
+
+    TEST_ASSERT_EQUAL(0, semver_registry_create(&g_p_registry, 16));
+    TEST_ASSERT_TRUE(semver_registry_report(g_p_registry, NULL, 0, NULL) < 0);
+    TEST_ASSERT_TRUE(semver_registry_latest(g_p_registry, "zlib", 4, NULL) < 0);
+    TEST_ASSERT_TRUE(semver_registry_latest(g_p_registry, "zlib", 4, &p_latest) > 0);
+}
+
+void test_semver_registry_keeps_newest(void)
+{
+    TEST_ASSERT_EQUAL(0, semver_registry_create(&g_p_registry, 16));
+
+    TEST_ASSERT_EQUAL(0, report("zlib", "1.2.3"));
+    TEST_ASSERT_TRUE(report("zlib", "1.2.2") > 0);
+    TEST_ASSERT_TRUE(report("zlib", "1.2.3+build.7") > 0);
+    TEST_ASSERT_EQUAL(0, report("zlib", "1.3.0-rc.1"));
+    TEST_ASSERT_TRUE(report("zlib", "1.3.0-beta.11") > 0);
+    TEST_ASSERT_EQUAL(0, report("zlib", "1.3.0-rc.1.1"));
+    assert_latest("zlib", "1.3.0-rc.1.1");
+    TEST_ASSERT_EQUAL(0, report("zlib", "1.3.0+sha.5114f85"));
+    TEST_ASSERT_TRUE(report("zlib", "1.3.0-rc.2") > 0);
+    assert_latest("zlib", "1.3.0+sha.5114f85");
+
+    //Packages do not see each other's versions.
+    TEST_ASSERT_EQUAL(0, report("zlib-ng", "0.1.0"));
+    assert_latest("zlib-ng", "0.1.0");
+    assert_latest("zlib", "1.3.0+sha.5114f85");
+}
+
+void test_semver_registry_versions_too_large_to_pack(void)
+{
+    TEST_ASSERT_EQUAL(0, semver_registry_create(&g_p_registry, 16));
+
+    TEST_ASSERT_EQUAL(0, report("tzdata", "2.0.0"));
+    TEST_ASSERT_EQUAL(0, report("tzdata", "20150223.0.0-rc.1"));
+    TEST_ASSERT_TRUE(report("tzdata", "2097150.0.0") > 0);
+    TEST_ASSERT_EQUAL(0, report("tzdata", "20150223.0.0"));
+    TEST_ASSERT_TRUE(report("tzdata", "20150223.0.0-rc.2") > 0);
+    TEST_ASSERT_EQUAL(0, report("tzdata", "20150223.0.4294967295"));
+    assert_latest("tzdata", "20150223.0.4294967295");
+}
+
+void test_semver_registry_snapshot(void)
+{
+    semver_registry_entry_t *p_entries = NULL;
+    size_t num_entries = 0;
+    char *p_str;
+    int len;
+    size_t i;
+    int j;
+
+    TEST_ASSERT_EQUAL(0, semver_registry_create(&g_p_registry, 2));
+    for(j=0;j<NUM_PACKAGES;j++)
+    {
+        report(g_packages[j], "1.0.0");
+        report(g_packages[j], "1.0.1");
+    }
+
+    TEST_ASSERT_EQUAL(0, semver_registry_snapshot(g_p_registry, &p_entries, &num_entries));
+    TEST_ASSERT_EQUAL(NUM_PACKAGES, num_entries);
+
+    for(i=0;i<num_entries;i++)
+    {
+        semver_to_str(p_entries[i].p_latest, &p_str, &len);
+        TEST_ASSERT_EQUAL_STRING("1.0.1", p_str);
+        free(p_str);
+
+        for(j=0;j<NUM_PACKAGES;j++)
+        {
+            if(strlen(g_packages[j]) == p_entries[i].package_len &&
+               0 == memcmp(g_packages[j], p_entries[i].package, p_entries[i].package_len))
+            {
+                break;
+            }
+        }
+        TEST_ASSERT_TRUE(j < NUM_PACKAGES);
+    }
+
+    free(p_entries);
+}
+
+void test_semver_registry_concurrent_reports(void)
+{
+    pthread_t threads[NUM_THREADS];
+    pthread_t reader;
+    void *p_ret;
+    char semver_str[32];
+    int i;
+
+    //The last one is the newest.
+    for(i=0;i<NUM_VERSIONS;i++)
+    {
+        sprintf(semver_str, "%d.%d.0%s", i / 100, (i / 5) % 20, g_pr_strs[i % 5]);
+        semver_str_to_semver(semver_str, strlen(semver_str), &g_versions[i]);
+    }
+
+    TEST_ASSERT_EQUAL(0, semver_registry_create(&g_p_registry, 2));
+
+    pthread_create(&reader, NULL, latest_thread, NULL);
+    for(i=0;i<NUM_THREADS;i++)
+    {
+        pthread_create(&threads[i], NULL, report_thread, (void*)(intptr_t)i);
+    }
+    for(i=0;i<NUM_THREADS;i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_join(reader, &p_ret);
+
+    TEST_ASSERT_NULL(p_ret);
+    for(i=0;i<NUM_PACKAGES;i++)
+    {
+        assert_latest(g_packages[i], "3.19.0");
+    }
+
+    for(i=0;i<NUM_VERSIONS;i++)
+    {
+        semver_destroy(g_versions[i]);
+    }
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static int report(const char* package, const char* semver_str)
+{
+    semver_t *p_semver = NULL;
+    int ret;
+
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver(semver_str, strlen(semver_str), &p_semver));
+    ret = semver_registry_report(g_p_registry, package, strlen(package), p_semver);
+    semver_destroy(p_semver);
+
+    return ret;
+}
+
+static void assert_latest(const char* package, const char* expected)
+{
+    const semver_t *p_latest;
+    char *p_str = NULL;
+    int len;
+
+    TEST_ASSERT_EQUAL(0, semver_registry_latest(g_p_registry, package, strlen(package), &p_latest));
+    TEST_ASSERT_EQUAL(0, semver_to_str(p_latest, &p_str, &len));
+    TEST_ASSERT_EQUAL_STRING(expected, p_str);
+    free(p_str);
+}
+
+//Reports every version of every package, each thread in another order.
+static void* report_thread(void *p_arg)
+{
+    int start = (int)(intptr_t)p_arg * (NUM_VERSIONS / NUM_THREADS);
+    int i;
+    int j;
+
+    for(i=0;i<NUM_VERSIONS;i++)
+    {
+        for(j=0;j<NUM_PACKAGES;j++)
+        {
+            semver_registry_report(g_p_registry, g_packages[j], strlen(g_packages[j]),
+                                   g_versions[(start + 37*i) % NUM_VERSIONS]);
+        }
+    }
+
+    return NULL;
+}
+
+//Checks that a package's latest version never goes backwards; returns
+//non-NULL if it does.
+static void* latest_thread(void *p_arg)
+{
+    const semver_t *p_prev = NULL;
+    const semver_t *p_latest;
+    int cmp;
+    int i;
+
+    (void)p_arg;
+
+    for(i=0;i<20*NUM_VERSIONS;i++)
+    {
+        if(0 == semver_registry_latest(g_p_registry, "curl", 4, &p_latest))
+        {
+            if(NULL != p_prev)
+            {
+                semver_compare(p_latest, p_prev, &cmp);
+                if(cmp < 0)
+                {
+                    return (void*)1;
+                }
+            }
+            p_prev = p_latest;
+        }
+    }
+
+    return NULL;
+}
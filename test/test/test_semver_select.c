@@ -0,0 +1,270 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_batch.h"
+#include "semver_select.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define NUM_RANDOM_ROWS 1013
+#define TOP_K 7
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static semver_batch_t *g_p_batch = NULL;
+static semver_t g_semvers[16];
+static int g_num_semvers = 0;
+
+static const char* g_pr_strs[] = { "", "", "-alpha", "-alpha.1", "-rc.1", "-rc.11" };
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void parse_all(const char** semver_strs, int num);
+static void assert_str(const char* expected, const semver_t *p_semver);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    g_p_batch = NULL;
+    g_num_semvers = 0;
+}
+
+void tearDown(void)
+{
+    int i;
+
+    if(NULL != g_p_batch)
+    {
+        semver_batch_destroy(g_p_batch);
+    }
+    for(i=0;i<g_num_semvers;i++)
+    {
+        semver_fini(&g_semvers[i]);
+    }
+}
+
+void test_semver_select_max_min(void)
+{
+    const char* semver_strs[] = { "1.0.0-rc.1", "1.0.0+build.1", "0.9.0",
+                                  "1.0.0-rc.11", "1.0.0+build.2", "0.9.0-alpha" };
+    size_t index;
+
+    parse_all(semver_strs, 6);
+
+    //Equal precedence: the first one wins.
+    TEST_ASSERT_EQUAL(0, semver_max(g_semvers, 6, &index));
+    TEST_ASSERT_EQUAL(1, index);
+    TEST_ASSERT_EQUAL(0, semver_min(g_semvers, 6, &index));
+    TEST_ASSERT_EQUAL(5, index);
+    TEST_ASSERT_EQUAL(0, semver_max(g_semvers, 1, &index));
+    TEST_ASSERT_EQUAL(0, index);
+
+    TEST_ASSERT_TRUE(semver_max(g_semvers, 0, &index) > 0);
+    TEST_ASSERT_TRUE(semver_min(NULL, 6, &index) < 0);
+    TEST_ASSERT_TRUE(semver_max(g_semvers, 6, NULL) < 0);
+}
+
+void test_semver_select_top_k(void)
+{
+    const char* semver_strs[] = { "2.0.0-beta", "1.4.2", "2.0.0+sha.1", "10.0.0",
+                                  "2.0.0+sha.2", "2.0.0-rc.1", "0.0.1" };
+    size_t indices[8];
+    size_t num;
+
+    parse_all(semver_strs, 7);
+
+    TEST_ASSERT_EQUAL(0, semver_top_k(g_semvers, 7, 4, indices, &num));
+    TEST_ASSERT_EQUAL(4, num);
+    TEST_ASSERT_EQUAL(3, indices[0]);
+    TEST_ASSERT_EQUAL(2, indices[1]);
+    TEST_ASSERT_EQUAL(4, indices[2]);
+    TEST_ASSERT_EQUAL(5, indices[3]);
+
+    //Asking for more than there is returns everything, sorted.
+    TEST_ASSERT_EQUAL(0, semver_top_k(g_semvers, 7, 8, indices, &num));
+    TEST_ASSERT_EQUAL(7, num);
+    TEST_ASSERT_EQUAL(0, indices[4]);
+    TEST_ASSERT_EQUAL(1, indices[5]);
+    TEST_ASSERT_EQUAL(6, indices[6]);
+
+    TEST_ASSERT_EQUAL(0, semver_top_k(g_semvers, 7, 0, indices, &num));
+    TEST_ASSERT_EQUAL(0, num);
+    TEST_ASSERT_NOT_EQUAL(0, semver_top_k(g_semvers, 7, 4, indices, NULL));
+}
+
+void test_semver_select_batch_matches_array(void)
+{
+    semver_t *rows[NUM_RANDOM_ROWS];
+    semver_t *p_semvers;
+    size_t valid_rows[NUM_RANDOM_ROWS];
+    size_t indices[TOP_K];
+    size_t top_rows[TOP_K];
+    size_t num_valid = 0;
+    size_t num_top;
+    size_t index;
+    size_t row;
+    char *buf;
+    size_t len = 0;
+    size_t i;
+
+    buf = (char*)malloc(NUM_RANDOM_ROWS * 32);
+    srand(2015);
+    for(i=0;i<NUM_RANDOM_ROWS;i++)
+    {
+        size_t start = len;
+
+        if(0 == rand() % 8)
+        {
+            len += sprintf(buf + len, "9.9.09\n");
+        }
+        else
+        {
+            len += sprintf(buf + len, "%d.%d.%d%s\n", rand() % 3, rand() % 3, rand() % 3,
+                           g_pr_strs[rand() % (sizeof(g_pr_strs)/sizeof(char*))]);
+        }
+
+        rows[i] = NULL;
+        semver_str_to_semver(buf + start, len - start - 1, &rows[i]);
+    }
+    TEST_ASSERT_EQUAL(0, semver_batch_parse(buf, len, &g_p_batch));
+
+    //The same versions, valid ones only, as an array.
+    p_semvers = (semver_t*)malloc(NUM_RANDOM_ROWS * sizeof(semver_t));
+    for(i=0;i<NUM_RANDOM_ROWS;i++)
+    {
+        if(NULL != rows[i])
+        {
+            valid_rows[num_valid] = i;
+            p_semvers[num_valid++] = *rows[i];
+        }
+    }
+
+    TEST_ASSERT_EQUAL(0, semver_max(p_semvers, num_valid, &index));
+    TEST_ASSERT_EQUAL(0, semver_batch_max(g_p_batch, buf, &row));
+    TEST_ASSERT_EQUAL(valid_rows[index], row);
+
+    TEST_ASSERT_EQUAL(0, semver_min(p_semvers, num_valid, &index));
+    TEST_ASSERT_EQUAL(0, semver_batch_min(g_p_batch, buf, &row));
+    TEST_ASSERT_EQUAL(valid_rows[index], row);
+
+    TEST_ASSERT_EQUAL(0, semver_top_k(p_semvers, num_valid, TOP_K, indices, &num_top));
+    TEST_ASSERT_EQUAL(0, semver_batch_top_k(g_p_batch, buf, TOP_K, top_rows, &num_top));
+    TEST_ASSERT_EQUAL(TOP_K, num_top);
+    for(i=0;i<TOP_K;i++)
+    {
+        TEST_ASSERT_EQUAL(valid_rows[indices[i]], top_rows[i]);
+    }
+
+    //Rows past the last whole vector go down the scalar path.
+    g_p_batch->count = 3;
+    for(num_valid=0;valid_rows[num_valid]<3;num_valid++)
+    {
+    }
+    TEST_ASSERT_EQUAL(0, semver_batch_max(g_p_batch, buf, &row));
+    TEST_ASSERT_EQUAL(0, semver_max(p_semvers, num_valid, &index));
+    TEST_ASSERT_EQUAL(valid_rows[index], row);
+
+    for(i=0;i<NUM_RANDOM_ROWS;i++)
+    {
+        semver_destroy(rows[i]);
+    }
+    free(p_semvers);
+    free(buf);
+}
+
+void test_semver_select_batch_without_valid_rows(void)
+{
+    char buf[] = "1.0\n"
+                 "x.y.z\n"
+                 "\n"
+                 "1.0.0.0\n"
+                 "01.0.0\n";
+    size_t rows[2];
+    size_t num;
+    size_t row;
+
+    TEST_ASSERT_EQUAL(0, semver_batch_parse(buf, strlen(buf), &g_p_batch));
+    TEST_ASSERT_TRUE(semver_batch_max(g_p_batch, buf, &row) > 0);
+    TEST_ASSERT_TRUE(semver_batch_min(g_p_batch, buf, &row) > 0);
+    TEST_ASSERT_EQUAL(0, semver_batch_top_k(g_p_batch, buf, 2, rows, &num));
+    TEST_ASSERT_EQUAL(0, num);
+    TEST_ASSERT_TRUE(semver_batch_max(NULL, buf, &row) < 0);
+}
+
+void test_semver_select_streaming_top_k(void)
+{
+    const char* semver_strs[] = { "1.0.0", "3.0.0-rc.1", "2.0.0+first", "0.1.0",
+                                  "2.0.0+second", "3.0.0-beta" };
+    semver_top_k_t top_k;
+    const semver_t *result[3];
+    size_t num;
+    int i;
+
+    TEST_ASSERT_NOT_EQUAL(0, semver_top_k_init(&top_k, 0));
+    TEST_ASSERT_EQUAL(0, semver_top_k_init(&top_k, 3));
+
+    //Versions are copied, so they need not outlive the push. 2.0.0+second
+    //gets in, but is the first to go: it ties with 2.0.0+first and came
+    //later.
+    for(i=0;i<6;i++)
+    {
+        semver_t *p_semver = NULL;
+
+        semver_str_to_semver(semver_strs[i], strlen(semver_strs[i]), &p_semver);
+        TEST_ASSERT_EQUAL(3 == i, semver_top_k_push(&top_k, p_semver) > 0);
+        semver_destroy(p_semver);
+    }
+
+    TEST_ASSERT_EQUAL(0, semver_top_k_result(&top_k, result, &num));
+    TEST_ASSERT_EQUAL(3, num);
+    assert_str("3.0.0-rc.1", result[0]);
+    assert_str("3.0.0-beta", result[1]);
+    assert_str("2.0.0+first", result[2]);
+
+    //The stream carries on after a result.
+    parse_all(semver_strs, 1);
+    semver_set_major(&g_semvers[0], 4);
+    TEST_ASSERT_EQUAL(0, semver_top_k_push(&top_k, &g_semvers[0]));
+    TEST_ASSERT_EQUAL(0, semver_top_k_result(&top_k, result, &num));
+    assert_str("4.0.0", result[0]);
+    assert_str("3.0.0-beta", result[2]);
+
+    TEST_ASSERT_EQUAL(0, semver_top_k_fini(&top_k));
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static void parse_all(const char** semver_strs, int num)
+{
+    semver_t *p_semver;
+    int i;
+
+    for(i=0;i<num;i++)
+    {
+        p_semver = NULL;
+        TEST_ASSERT_EQUAL(0, semver_str_to_semver(semver_strs[i], strlen(semver_strs[i]), &p_semver));
+        g_semvers[g_num_semvers++] = *p_semver;
+        free(p_semver);
+    }
+}
+
+static void assert_str(const char* expected, const semver_t *p_semver)
+{
+    char *p_str = NULL;
+    int len;
+
+    TEST_ASSERT_EQUAL(0, semver_to_str(p_semver, &p_str, &len));
+    TEST_ASSERT_EQUAL_STRING(expected, p_str);
+    free(p_str);
+}
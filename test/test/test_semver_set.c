@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_set.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define NUM_THREADS  8
+#define NUM_VERSIONS 600
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef struct collect_
+{
+    const semver_t *semvers[NUM_VERSIONS];
+    int count;
+    int limit;
+} collect_t;
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static semver_set_t *g_p_set = NULL;
+static semver_t *g_versions[NUM_VERSIONS];
+
+static const char* g_pr_strs[] = { "", "-alpha", "-alpha.1", "-beta", "-rc.1", "-rc.11" };
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static semver_t* parse(const char* semver_str);
+static void assert_str(const char* expected, const semver_t *p_semver);
+static int collect(void *p_ctx, const semver_t *p_semver);
+static void* insert_thread(void *p_arg);
+static void* ceiling_thread(void *p_arg);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    g_p_set = NULL;
+}
+
+void tearDown(void)
+{
+    if(NULL != g_p_set)
+    {
+        semver_set_destroy(g_p_set);
+    }
+}
+
+void test_semver_set_insert_orders_by_precedence(void)
+{
+    const char* semver_strs[] = { "1.0.0", "1.0.0-rc.1", "0.9.12", "1.0.0-alpha",
+                                  "1.0.0-alpha.1", "10.0.0", "1.0.0-beta.11",
+                                  "1.0.0-beta.2", "2.0.0+build.7" };
+    const char* sorted_strs[] = { "0.9.12", "1.0.0-alpha", "1.0.0-alpha.1",
+                                  "1.0.0-beta.2", "1.0.0-beta.11", "1.0.0-rc.1",
+                                  "1.0.0", "2.0.0+build.7", "10.0.0" };
+    const int num = sizeof(semver_strs)/sizeof(char*);
+    semver_t *p_semver;
+    collect_t collected = { .count = 0, .limit = NUM_VERSIONS };
+    int i;
+
+    TEST_ASSERT_EQUAL(0, semver_set_create(&g_p_set));
+
+    for(i=0;i<num;i++)
+    {
+        p_semver = parse(semver_strs[i]);
+        TEST_ASSERT_EQUAL(0, semver_set_insert(g_p_set, p_semver));
+        semver_destroy(p_semver);
+    }
+
+    //Equal precedence is the same element, build meta-data or not.
+    p_semver = parse("2.0.0+build.8");
+    TEST_ASSERT_TRUE(semver_set_insert(g_p_set, p_semver) > 0);
+    semver_destroy(p_semver);
+    p_semver = parse("1.0.0-rc.1");
+    TEST_ASSERT_TRUE(semver_set_insert(g_p_set, p_semver) > 0);
+    semver_destroy(p_semver);
+
+    TEST_ASSERT_EQUAL(num, semver_set_size(g_p_set));
+    TEST_ASSERT_EQUAL(0, semver_set_range(g_p_set, NULL, NULL, collect, &collected));
+    TEST_ASSERT_EQUAL(num, collected.count);
+
+    for(i=0;i<num;i++)
+    {
+        assert_str(sorted_strs[i], collected.semvers[i]);
+    }
+}
+
+void test_semver_set_floor_ceiling_find(void)
+{
+    const char* semver_strs[] = { "1.0.0-rc.1", "1.0.0", "1.2.0", "2.0.0-beta" };
+    semver_t *p_query;
+    const semver_t *p_found;
+    int i;
+
+    TEST_ASSERT_EQUAL(0, semver_set_create(&g_p_set));
+    for(i=0;i<4;i++)
+    {
+        p_query = parse(semver_strs[i]);
+        semver_set_insert(g_p_set, p_query);
+        semver_destroy(p_query);
+    }
+
+    p_query = parse("1.0.0-rc.2");
+    TEST_ASSERT_EQUAL(0, semver_set_floor(g_p_set, p_query, &p_found));
+    assert_str("1.0.0-rc.1", p_found);
+    TEST_ASSERT_EQUAL(0, semver_set_ceiling(g_p_set, p_query, &p_found));
+    assert_str("1.0.0", p_found);
+    TEST_ASSERT_TRUE(semver_set_find(g_p_set, p_query, &p_found) > 0);
+    semver_destroy(p_query);
+
+    p_query = parse("1.2.0+sha.5114f85");
+    TEST_ASSERT_EQUAL(0, semver_set_find(g_p_set, p_query, &p_found));
+    TEST_ASSERT_EQUAL(0, semver_set_floor(g_p_set, p_query, &p_found));
+    assert_str("1.2.0", p_found);
+    semver_destroy(p_query);
+
+    p_query = parse("2.0.0");
+    TEST_ASSERT_EQUAL(0, semver_set_floor(g_p_set, p_query, &p_found));
+    assert_str("2.0.0-beta", p_found);
+    TEST_ASSERT_TRUE(semver_set_ceiling(g_p_set, p_query, &p_found) > 0);
+    semver_destroy(p_query);
+
+    p_query = parse("1.0.0-alpha");
+    TEST_ASSERT_TRUE(semver_set_floor(g_p_set, p_query, &p_found) > 0);
+    semver_destroy(p_query);
+}
+
+void test_semver_set_range_bounds(void)
+{
+    semver_t *p_lo;
+    semver_t *p_hi;
+    collect_t collected = { .count = 0, .limit = NUM_VERSIONS };
+    char buf[32];
+    int i;
+
+    TEST_ASSERT_EQUAL(0, semver_set_create(&g_p_set));
+    for(i=0;i<10;i++)
+    {
+        sprintf(buf, "1.%d.0", i);
+        p_lo = parse(buf);
+        semver_set_insert(g_p_set, p_lo);
+        semver_destroy(p_lo);
+    }
+
+    //[1.3.0, 1.7.0)
+    p_lo = parse("1.3.0");
+    p_hi = parse("1.7.0");
+    TEST_ASSERT_EQUAL(0, semver_set_range(g_p_set, p_lo, p_hi, collect, &collected));
+    TEST_ASSERT_EQUAL(4, collected.count);
+    assert_str("1.3.0", collected.semvers[0]);
+    assert_str("1.6.0", collected.semvers[3]);
+
+    //A callback returning nonzero stops the scan.
+    collected.count = 0;
+    collected.limit = 2;
+    TEST_ASSERT_TRUE(semver_set_range(g_p_set, p_lo, NULL, collect, &collected) > 0);
+    TEST_ASSERT_EQUAL(2, collected.count);
+
+    TEST_ASSERT_TRUE(semver_set_range(g_p_set, p_lo, p_hi, NULL, NULL) < 0);
+    TEST_ASSERT_TRUE(semver_set_insert(NULL, p_lo) < 0);
+    TEST_ASSERT_EQUAL(0, semver_set_size(NULL));
+
+    semver_destroy(p_lo);
+    semver_destroy(p_hi);
+}
+
+void test_semver_set_found_versions_outlive_the_set(void)
+{
+    semver_t *p_semver;
+    const semver_t *p_found;
+
+    TEST_ASSERT_EQUAL(0, semver_set_create(&g_p_set));
+
+    p_semver = parse("3.1.4-rc.1+build.59");
+    semver_set_insert(g_p_set, p_semver);
+    TEST_ASSERT_EQUAL(0, semver_set_find(g_p_set, p_semver, &p_found));
+    TEST_ASSERT_TRUE(p_found != p_semver);
+    semver_destroy(p_semver);
+
+    semver_ref(p_found);
+    semver_set_destroy(g_p_set);
+    g_p_set = NULL;
+
+    assert_str("3.1.4-rc.1+build.59", p_found);
+    semver_unref(p_found);
+}
+
+void test_semver_set_concurrent_inserts(void)
+{
+    pthread_t threads[NUM_THREADS];
+    pthread_t reader;
+    collect_t collected = { .count = 0, .limit = NUM_VERSIONS };
+    char buf[32];
+    int num_inserted = 0;
+    void *p_ret;
+    bool reader_ok;
+    int cmp;
+    int i;
+
+    for(i=0;i<NUM_VERSIONS;i++)
+    {
+        sprintf(buf, "%d.%d.%d%s", i % 5, (i / 5) % 4, (i / 20) % 5, g_pr_strs[i / 100]);
+        g_versions[i] = parse(buf);
+    }
+
+    TEST_ASSERT_EQUAL(0, semver_set_create(&g_p_set));
+
+    pthread_create(&reader, NULL, ceiling_thread, NULL);
+    for(i=0;i<NUM_THREADS;i++)
+    {
+        pthread_create(&threads[i], NULL, insert_thread, (void*)(intptr_t)i);
+    }
+    for(i=0;i<NUM_THREADS;i++)
+    {
+        pthread_join(threads[i], &p_ret);
+        num_inserted += (int)(intptr_t)p_ret;
+    }
+    pthread_join(reader, &p_ret);
+    reader_ok = (NULL == p_ret);
+
+    //Every thread tried every version; exactly one insert of each won.
+    TEST_ASSERT_TRUE(reader_ok);
+    TEST_ASSERT_EQUAL(NUM_VERSIONS, num_inserted);
+    TEST_ASSERT_EQUAL(NUM_VERSIONS, semver_set_size(g_p_set));
+
+    semver_set_range(g_p_set, NULL, NULL, collect, &collected);
+    TEST_ASSERT_EQUAL(NUM_VERSIONS, collected.count);
+    for(i=1;i<NUM_VERSIONS;i++)
+    {
+        semver_compare(collected.semvers[i-1], collected.semvers[i], &cmp);
+        TEST_ASSERT_TRUE(cmp < 0);
+    }
+
+    for(i=0;i<NUM_VERSIONS;i++)
+    {
+        semver_destroy(g_versions[i]);
+    }
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static semver_t* parse(const char* semver_str)
+{
+    semver_t *p_semver = NULL;
+
+    TEST_ASSERT_EQUAL(0, semver_str_to_semver(semver_str, strlen(semver_str), &p_semver));
+    return p_semver;
+}
+
+static void assert_str(const char* expected, const semver_t *p_semver)
+{
+    char *p_str = NULL;
+    int len;
+
+    TEST_ASSERT_EQUAL(0, semver_to_str(p_semver, &p_str, &len));
+    TEST_ASSERT_EQUAL_STRING(expected, p_str);
+    free(p_str);
+}
+
+static int collect(void *p_ctx, const semver_t *p_semver)
+{
+    collect_t *p_collect = (collect_t*)p_ctx;
+
+    if(p_collect->count == p_collect->limit)
+    {
+        return 1;
+    }
+
+    p_collect->semvers[p_collect->count++] = p_semver;
+    return 0;
+}
+
+//Inserts every version, each thread starting somewhere else, and returns
+//how many of its inserts won.
+static void* insert_thread(void *p_arg)
+{
+    int start = (int)(intptr_t)p_arg * (NUM_VERSIONS / NUM_THREADS);
+    intptr_t num_inserted = 0;
+    int i;
+
+    for(i=0;i<NUM_VERSIONS;i++)
+    {
+        num_inserted += (0 == semver_set_insert(g_p_set, g_versions[(start + i) % NUM_VERSIONS]));
+    }
+
+    return (void*)num_inserted;
+}
+
+//Checks ceilings while the inserts run; returns non-NULL on a wrong one.
+static void* ceiling_thread(void *p_arg)
+{
+    const semver_t *p_found;
+    int cmp;
+    int i;
+
+    (void)p_arg;
+
+    for(i=0;i<4*NUM_VERSIONS;i++)
+    {
+        if(0 == semver_set_ceiling(g_p_set, g_versions[(i * 7) % NUM_VERSIONS], &p_found))
+        {
+            semver_compare(p_found, g_versions[(i * 7) % NUM_VERSIONS], &cmp);
+            if(cmp < 0)
+            {
+                return (void*)1;
+            }
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_sort.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define NUM_RANDOM 5000
+#define NUM_PARALLEL (4 * SEMVER_SORT_PARALLEL_MIN)
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static semver_t *g_semvers = NULL;
+static size_t g_num_semvers = 0;
+
+static const char* g_pr_strs[] = { "", "", "", "-alpha", "-alpha.1", "-alpha.beta",
+                                   "-beta.2", "-beta.11", "-rc.1", "-1" };
+static const char* g_bmd_strs[] = { "", "+a", "+b" };
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void make_semvers(size_t num, uint32_t max_number);
+static void assert_sorted_stable(const size_t *order, size_t num);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    g_semvers = NULL;
+    g_num_semvers = 0;
+}
+
+void tearDown(void)
+{
+    size_t i;
+
+    for(i=0;i<g_num_semvers;i++)
+    {
+        semver_fini(&g_semvers[i]);
+    }
+    free(g_semvers);
+}
+
+void test_semver_sort_null_params(void)
+{
+    semver_t semver;
+    size_t order[1];
+
+    TEST_ASSERT_EQUAL(0, semver_sort_order(NULL, 0, NULL));
+    TEST_ASSERT_NOT_EQUAL(0, semver_sort_order(NULL, 1, order));
+    TEST_ASSERT_NOT_EQUAL(0, semver_sort_order(&semver, 1, NULL));
+    TEST_ASSERT_EQUAL(0, semver_sort(NULL, 0));
+    TEST_ASSERT_NOT_EQUAL(0, semver_sort(NULL, 1));
+}
+
+void test_semver_sort_small_array(void)
+{
+    const char* semver_strs[] = { "1.0.0", "1.0.0-rc.1", "1.0.0+b", "0.9.0",
+                                  "1.0.0-alpha", "1.0.0+a", "1.0.0-alpha.1" };
+    const char* sorted_strs[] = { "0.9.0", "1.0.0-alpha", "1.0.0-alpha.1", "1.0.0-rc.1",
+                                  "1.0.0", "1.0.0+b", "1.0.0+a" };
+    char *p_str;
+    int len;
+    size_t i;
+
+    g_semvers = (semver_t*)malloc(7 * sizeof(semver_t));
+    for(i=0;i<7;i++)
+    {
+        semver_t *p_semver = NULL;
+
+        semver_str_to_semver(semver_strs[i], strlen(semver_strs[i]), &p_semver);
+        g_semvers[g_num_semvers++] = *p_semver;
+        free(p_semver);
+    }
+
+    //Equal precedence keeps input order: +b came before +a.
+    TEST_ASSERT_EQUAL(0, semver_sort(g_semvers, g_num_semvers));
+    for(i=0;i<7;i++)
+    {
+        semver_to_str(&g_semvers[i], &p_str, &len);
+        TEST_ASSERT_EQUAL_STRING(sorted_strs[i], p_str);
+        free(p_str);
+    }
+}
+
+void test_semver_sort_radix_small_numbers(void)
+{
+    size_t *order = (size_t*)malloc(NUM_RANDOM * sizeof(size_t));
+
+    make_semvers(NUM_RANDOM, 4);
+    TEST_ASSERT_EQUAL(0, semver_sort_order(g_semvers, g_num_semvers, order));
+    assert_sorted_stable(order, g_num_semvers);
+
+    free(order);
+}
+
+void test_semver_sort_radix_large_numbers(void)
+{
+    size_t *order = (size_t*)malloc(NUM_RANDOM * sizeof(size_t));
+
+    //Every digit of the key varies.
+    make_semvers(NUM_RANDOM, UINT32_MAX);
+    TEST_ASSERT_EQUAL(0, semver_sort_order(g_semvers, g_num_semvers, order));
+    assert_sorted_stable(order, g_num_semvers);
+
+    free(order);
+}
+
+void test_semver_sort_in_place_matches_order(void)
+{
+    semver_t *copies;
+    size_t *order = (size_t*)malloc(NUM_RANDOM * sizeof(size_t));
+    int result;
+    size_t i;
+
+    make_semvers(NUM_RANDOM, 3);
+    copies = (semver_t*)malloc(NUM_RANDOM * sizeof(semver_t));
+    memcpy(copies, g_semvers, NUM_RANDOM * sizeof(semver_t));
+
+    TEST_ASSERT_EQUAL(0, semver_sort_order(g_semvers, g_num_semvers, order));
+    TEST_ASSERT_EQUAL(0, semver_sort(g_semvers, g_num_semvers));
+
+    //Sorting moves the structs, so the tails move with them.
+    for(i=0;i<NUM_RANDOM;i++)
+    {
+        semver_compare(&g_semvers[i], &copies[order[i]], &result);
+        TEST_ASSERT_EQUAL(0, result);
+        TEST_ASSERT_EQUAL(copies[order[i]].bmd_len, g_semvers[i].bmd_len);
+    }
+
+    free(copies);
+    free(order);
+}
+
+void test_semver_sort_parallel_matches_serial(void)
+{
+    size_t *order = (size_t*)malloc(NUM_PARALLEL * sizeof(size_t));
+    size_t *order_parallel = (size_t*)malloc(NUM_PARALLEL * sizeof(size_t));
+
+    //Few distinct cores, so runs of equal keys straddle the splitters.
+    make_semvers(NUM_PARALLEL, 40);
+    TEST_ASSERT_EQUAL(0, semver_sort_order(g_semvers, g_num_semvers, order));
+    TEST_ASSERT_EQUAL(0, semver_sort_order_parallel(g_semvers, g_num_semvers, 4, order_parallel));
+    TEST_ASSERT_EQUAL_MEMORY(order, order_parallel, NUM_PARALLEL * sizeof(size_t));
+
+    //One thread per CPU, whatever that is here.
+    TEST_ASSERT_EQUAL(0, semver_sort_order_parallel(g_semvers, g_num_semvers, 0, order_parallel));
+    TEST_ASSERT_EQUAL_MEMORY(order, order_parallel, NUM_PARALLEL * sizeof(size_t));
+
+    free(order);
+    free(order_parallel);
+}
+
+void test_semver_sort_parallel_one_core(void)
+{
+    size_t *order = (size_t*)malloc(NUM_PARALLEL * sizeof(size_t));
+
+    //Every splitter is the same key: all but one bucket end up empty.
+    make_semvers(NUM_PARALLEL, 0);
+    TEST_ASSERT_EQUAL(0, semver_sort_order_parallel(g_semvers, g_num_semvers, 8, order));
+    assert_sorted_stable(order, g_num_semvers);
+
+    free(order);
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static void make_semvers(size_t num, uint32_t max_number)
+{
+    char semver_str[64];
+    semver_t *p_semver;
+    size_t i;
+
+    g_semvers = (semver_t*)malloc(num * sizeof(semver_t));
+    srand(2015);
+    for(i=0;i<num;i++)
+    {
+        uint32_t major = ((uint32_t)rand() * 2654435761u) % ((uint64_t)max_number + 1);
+        uint32_t minor = ((uint32_t)rand() * 2654435761u) % ((uint64_t)max_number + 1);
+        uint32_t patch = ((uint32_t)rand() * 2654435761u) % ((uint64_t)max_number + 1);
+
+        sprintf(semver_str, "%u.%u.%u%s%s", major, minor, patch,
+                g_pr_strs[rand() % (sizeof(g_pr_strs)/sizeof(char*))],
+                g_bmd_strs[rand() % (sizeof(g_bmd_strs)/sizeof(char*))]);
+        p_semver = NULL;
+        TEST_ASSERT_EQUAL(0, semver_str_to_semver(semver_str, strlen(semver_str), &p_semver));
+        g_semvers[g_num_semvers++] = *p_semver;
+        free(p_semver);
+    }
+}
+
+static void assert_sorted_stable(const size_t *order, size_t num)
+{
+    bool *seen = (bool*)calloc(num, sizeof(bool));
+    int result;
+    size_t i;
+
+    for(i=0;i<num;i++)
+    {
+        TEST_ASSERT_TRUE(order[i] < num);
+        TEST_ASSERT_FALSE(seen[order[i]]);
+        seen[order[i]] = true;
+
+        if(i > 0)
+        {
+            semver_compare(&g_semvers[order[i-1]], &g_semvers[order[i]], &result);
+            TEST_ASSERT_TRUE(result <= 0);
+            if(0 == result)
+            {
+                TEST_ASSERT_TRUE(order[i-1] < order[i]);
+            }
+        }
+    }
+
+    free(seen);
+}
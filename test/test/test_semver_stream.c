@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "semver.h"
+#include "semver_stream.h"
+
+/******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define MAX_VERSIONS 16
+
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+typedef struct seen_
+{
+    int count;
+    char versions[MAX_VERSIONS][64];
+} seen_t;
+
+/******************************************************************************
+ * static variables
+ ******************************************************************************/
+static const char g_text[] =
+    "1.0.0\n"
+    "2.0.0-rc.1+build.5\r\n"
+    "not-a-version 1.2\t3.4.5-alpha.01\n"
+    "\n"
+    "10.20.30-x.7.z.92+sha.5114f85 0.0.1";
+
+static const char* g_expected[] =
+{
+    "1.0.0",
+    "2.0.0-rc.1+build.5",
+    "10.20.30-x.7.z.92+sha.5114f85",
+    "0.0.1",
+};
+
+static seen_t g_seen;
+static semver_stream_t g_stream;
+
+/******************************************************************************
+ * static function prototypes
+ ******************************************************************************/
+static void collect(void *p_ctx, const semver_t *p_semver);
+static void check_expected(void);
+
+/******************************************************************************
+ * non-static function definitions
+ ******************************************************************************/
+
+void setUp(void)
+{
+    memset(&g_seen, 0, sizeof(g_seen));
+    TEST_ASSERT_EQUAL(0, semver_stream_init(&g_stream, collect, &g_seen));
+}
+
+void tearDown(void)
+{
+    semver_stream_finish(&g_stream);
+}
+
+void test_semver_stream_null_params(void)
+{
+    TEST_ASSERT_NOT_EQUAL(0, semver_stream_init(NULL, collect, &g_seen));
+    TEST_ASSERT_NOT_EQUAL(0, semver_stream_init(&g_stream, NULL, &g_seen));
+    TEST_ASSERT_TRUE(semver_stream_feed(NULL, "1.0.0", 5) < 0);
+    TEST_ASSERT_TRUE(semver_stream_feed(&g_stream, NULL, 5) < 0);
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, NULL, 0));
+    TEST_ASSERT_TRUE(semver_stream_finish(NULL) < 0);
+}
+
+void test_semver_stream_one_chunk(void)
+{
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, g_text, strlen(g_text)));
+
+    //The last token might go on in the next chunk.
+    TEST_ASSERT_EQUAL(3, g_seen.count);
+
+    TEST_ASSERT_EQUAL(0, semver_stream_finish(&g_stream));
+    check_expected();
+    TEST_ASSERT_EQUAL(3, g_stream.num_invalid);
+}
+
+void test_semver_stream_every_split(void)
+{
+    size_t len = strlen(g_text);
+    size_t split_a;
+    size_t split_b;
+
+    //Every way of cutting the text into three chunks gives the same
+    //tokens.
+    for(split_a=0;split_a<=len;split_a++)
+    {
+        for(split_b=split_a;split_b<=len;split_b+=7)
+        {
+            semver_stream_finish(&g_stream);
+            setUp();
+
+            TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, g_text, split_a));
+            TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, g_text + split_a, split_b - split_a));
+            TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, g_text + split_b, len - split_b));
+            TEST_ASSERT_EQUAL(0, semver_stream_finish(&g_stream));
+
+            check_expected();
+            TEST_ASSERT_EQUAL(3, g_stream.num_invalid);
+        }
+    }
+}
+
+void test_semver_stream_byte_at_a_time(void)
+{
+    size_t i;
+
+    for(i=0;i<strlen(g_text);i++)
+    {
+        TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, g_text + i, 1));
+    }
+    TEST_ASSERT_EQUAL(0, semver_stream_finish(&g_stream));
+
+    check_expected();
+}
+
+void test_semver_stream_long_tokens(void)
+{
+    char token[SEMVER_STREAM_MAX_TOKEN_LEN + 8];
+
+    //Exactly the longest token allowed, split in two, is parsed...
+    memset(token, 'a', sizeof(token));
+    memcpy(token, "1.2.3-", 6);
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, token, 100));
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, token + 100, SEMVER_STREAM_MAX_TOKEN_LEN - 100));
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, " ", 1));
+    TEST_ASSERT_EQUAL(1, g_seen.count);
+
+    //...one byte more is not, whether split or not.
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, token, 100));
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, token + 100, SEMVER_STREAM_MAX_TOKEN_LEN - 99));
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, " ", 1));
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, token, SEMVER_STREAM_MAX_TOKEN_LEN + 1));
+    TEST_ASSERT_EQUAL(0, semver_stream_feed(&g_stream, "\n", 1));
+    TEST_ASSERT_EQUAL(1, g_seen.count);
+    TEST_ASSERT_EQUAL(2, g_stream.num_invalid);
+}
+
+/******************************************************************************
+ * static function definitions
+ ******************************************************************************/
+static void collect(void *p_ctx, const semver_t *p_semver)
+{
+    seen_t *p_seen = (seen_t*)p_ctx;
+    char *p_str;
+    int str_len;
+
+    TEST_ASSERT_TRUE(p_seen->count < MAX_VERSIONS);
+    TEST_ASSERT_EQUAL(0, semver_to_str(p_semver, &p_str, &str_len));
+    snprintf(p_seen->versions[p_seen->count++], sizeof(p_seen->versions[0]), "%s", p_str);
+    free(p_str);
+}
+
+static void check_expected(void)
+{
+    int i;
+
+    TEST_ASSERT_EQUAL(sizeof(g_expected)/sizeof(char*), g_seen.count);
+    for(i=0;i<g_seen.count;i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(g_expected[i], g_seen.versions[i]);
+    }
+    TEST_ASSERT_EQUAL(g_seen.count, g_stream.num_valid);
+}